@@ -41,6 +41,7 @@ extern ADC_HandleTypeDef hadc2;
 void MX_ADC2_Init(void);
 
 /* USER CODE BEGIN Prototypes */
+uint32_t Read_Temperature(void);
 
 /* USER CODE END Prototypes */
 
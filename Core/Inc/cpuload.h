@@ -0,0 +1,60 @@
+#ifndef __CPULOAD_H
+#define __CPULOAD_H
+
+#include "main.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * CPU 占用率：所有空闲路径都经 LOAD_Wfi 休眠，只统计 WFI 本身的周期数（调用时中断已关，
+ * 唤醒后中断处理尚未执行），其余时间都算忙，包括休眠期间穿插执行的中断。
+ * 每秒由软件定时器取样一次，保留最近 60 个 1 秒样本，给出 1s/10s/60s 平均与峰值。
+ * 各项同时在指标块中（metrics.h）：load_1s/10s/60s/peak_permille 仪表与 load_samples 计数器。
+ */
+#define LOAD_HISTORY 60u
+
+typedef struct {
+    uint16_t load_1s;       // 千分比
+    uint16_t load_10s;
+    uint16_t load_60s;
+    uint16_t peak;          // LOAD_Init 或 LOAD_ResetPeak 以来最大的 1 秒样本
+    uint32_t samples;       // 已取样次数
+} LOAD_Stats;
+
+// 遥测 TLM_CH_CPULOAD 的数据（小端）
+typedef LOAD_Stats LOAD_Report;
+
+extern uint32_t load_sleep_cycles;
+
+/**
+ * @brief 计入休眠时间的 WFI，须在中断关闭（PRIMASK）时调用
+ */
+static inline void LOAD_Wfi(void)
+{
+    uint32_t start = DWT->CYCCNT;
+    __DSB();
+    __WFI();
+    load_sleep_cycles += DWT->CYCCNT - start;
+}
+
+/**
+ * @brief 启动每秒取样的软件定时器，须在 SWT_Init 与 MONO_Init 之后调用
+ */
+void LOAD_Init(void);
+
+void LOAD_GetStats(LOAD_Stats *out);
+
+void LOAD_ResetPeak(void);
+
+/**
+ * @brief 经遥测发送当前统计，只能在线程上下文调用
+ */
+void LOAD_Dump(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __CPULOAD_H
@@ -0,0 +1,77 @@
+#ifndef __CRASH_H
+#define __CRASH_H
+
+#include "main.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 故障现场保存：HardFault/MemManage/BusFault/UsageFault 处理函数用 CRASH_CAPTURE() 把异常入栈的
+ * R0–R3、R12、LR、PC、xPSR 和 CFSR/HFSR/BFAR/MMFAR 写入 .noinit 段（链接脚本中位于 .bss 之前，
+ * 启动代码既不清零也不填充栈色），冻结事件跟踪环（trace.h，环本身也在 .noinit 中），然后软件复位。
+ * 下次启动 CRASH_Init 校验并取出记录，CRASH_Report 经日志报告，事件环保持冻结等待转储。
+ *
+ * 定位：arm-none-eabi-addr2line -e build/DEV.elf <pc> <lr>；CFSR/HFSR 各位含义见 PM0056 4.4.14–4.4.15。
+ */
+#define CRASH_MAGIC      0xC0DEDEADu    // 记录有效，尚未报告
+#define CRASH_MAGIC_SEEN 0xC0DEBEEFu    // 已报告，只保留累计次数
+
+typedef struct {
+    uint32_t magic;
+    uint32_t count;         // 上电以来的故障次数
+    uint32_t exception;     // 异常号：3 HardFault，4 MemManage，5 BusFault，6 UsageFault
+    uint32_t r0;
+    uint32_t r1;
+    uint32_t r2;
+    uint32_t r3;
+    uint32_t r12;
+    uint32_t lr;
+    uint32_t pc;            // 出错指令（精确总线错误）或其后的指令
+    uint32_t xpsr;
+    uint32_t exc_return;    // 进入异常时的 LR，位 2 为 1 表示帧在 PSP 上
+    uint32_t cfsr;
+    uint32_t hfsr;
+    uint32_t bfar;          // CFSR.BFARVALID 置位时有效
+    uint32_t mmfar;         // CFSR.MMARVALID 置位时有效
+    uint32_t trace_head;    // 故障时 trace_head，未开启 TRACE_ENABLE 时为 0
+    uint32_t check;         // magic 和 check 以外各字之和取反
+} CRASH_Record;
+
+/**
+ * @brief 在故障处理函数开头调用（须在任何其他语句之前），不返回
+ *        入栈帧地址取自本函数入口处的 SP（__builtin_dwarf_cfa），不受处理函数序言压栈影响
+ */
+#define CRASH_CAPTURE() \
+    CRASH_Fault((const uint32_t *)__builtin_dwarf_cfa(), (uint32_t)__builtin_return_address(0))
+
+/**
+ * @brief 保存现场并复位，由 CRASH_CAPTURE 调用
+ * @param frame MSP 上的异常入栈帧
+ * @param exc_return 进入异常时的 LR
+ */
+void CRASH_Fault(const uint32_t *frame, uint32_t exc_return) __attribute__((noreturn));
+
+/**
+ * @brief 取出上次复位前的故障记录，并打开 MemManage/BusFault/UsageFault 独立处理
+ *        须在 HAL_Init 之前调用（SysTick 开始后中断会写入事件环，覆盖故障前的事件）
+ */
+void CRASH_Init(void);
+
+/**
+ * @brief 本次启动前的故障记录，没有时返回 NULL
+ */
+const CRASH_Record *CRASH_GetLast(void);
+
+/**
+ * @brief 有故障记录时经日志报告，日志初始化之后调用
+ * @retval 1 有记录且事件环保留了故障前的事件，调用方应安排 TRACE_Dump；否则 0
+ */
+uint8_t CRASH_Report(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __CRASH_H
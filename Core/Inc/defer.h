@@ -0,0 +1,53 @@
+#ifndef __DEFER_H
+#define __DEFER_H
+
+#include "main.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * 延后工作项：由中断提交，在最低优先级的 PendSV 中执行
+ * 工作项由调用方静态分配，提交时用 LDREX/STREX 无锁挂入链表，不屏蔽任何中断，
+ * 包括抢占 0 的 TIM2 在内的任意中断都可提交；不会因队列满而丢失，执行前重复提交同一工作项只运行一次
+ */
+typedef struct DEFER_Work {
+    struct DEFER_Work *next;
+    void (*run)(void *arg);
+    void *arg;
+    volatile uint8_t pending;   // 由延后队列维护
+} DEFER_Work;
+
+#define DEFER_WORK_INIT(fn, a) {NULL, (fn), (a), 0}
+
+/*
+ * 统计登记在指标块中（metrics.h）：
+ *   defer_posted     实际入队次数
+ *   defer_coalesced  已在队列中而被合并的提交次数
+ *   defer_runs       PendSV 执行批次
+ *   defer_batch_max  单次 PendSV 执行的最多工作项数
+ */
+
+/**
+ * @brief 初始化队列，PendSV 的优先级见 irq.h
+ */
+void DEFER_Init(void);
+
+/**
+ * @brief 提交工作项并挂起 PendSV，可在任意中断或线程上下文调用
+ * @retval 1 已入队；0 工作项尚未执行，本次与之合并
+ */
+uint8_t DEFER_Post(DEFER_Work *work);
+
+/**
+ * @brief 依次执行队列中的工作项，在 PendSV_Handler 中调用
+ *        执行期间提交的工作项在本次返回前一并执行
+ */
+void DEFER_Handler(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __DEFER_H
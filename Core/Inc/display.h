@@ -0,0 +1,57 @@
+#ifndef __DISPLAY_H
+#define __DISPLAY_H
+
+#include "main.h"
+#include "seg7.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 显示字段，位置与宽度见 display.c 中的字段表
+typedef enum {
+    DISP_FIELD_TEMP = 0,    // 温度：第0–2位，一位小数
+    DISP_FIELD_FLOW,        // 流量：第3–5位
+    DISP_FIELD_COUNT
+} DISP_Field;
+
+/*
+ * 调优用计数器登记在指标块中（metrics.h），随每秒的快照发出：
+ *   disp_published      提交给刷新引擎的帧数
+ *   disp_skipped        无任何位变化而跳过的帧数
+ *   disp_busy           刷新引擎尚未取走上一帧、推迟提交的次数
+ *   disp_cells_encoded  实际重新编码的数码管位数
+ */
+
+/**
+ * @brief 清空缓存，下一次设置每个字段时都会完整编码
+ */
+void DISP_Init(void);
+
+/**
+ * @brief 在字段中显示定点数（frac 为小数位数），与上次相同则直接返回
+ *        只重新编码显示内容发生变化的位
+ */
+void DISP_SetFixed(DISP_Field field, int32_t value, uint8_t frac);
+
+/**
+ * @brief 在字段中显示状态字（---、Err、OPn、Sht）
+ */
+void DISP_SetGlyph(DISP_Field field, SEG7_Glyph glyph);
+
+/**
+ * @brief 设置整帧亮度，下一次 DISP_Flush 时重新提交
+ */
+void DISP_SetBrightness(uint8_t level);
+
+/**
+ * @brief 若自上次提交以来有位发生变化，则提交新帧
+ * @retval HAL_OK 已提交或无需提交；HAL_BUSY 刷新引擎忙，下次调用重试
+ */
+HAL_StatusTypeDef DISP_Flush(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __DISPLAY_H
@@ -1,26 +1,43 @@
 /**
- ****************************************************************************************************
- * @file        exti.h
- * @author      正点原子团队(ALIENTEK)
- * @version     V1.0
- * @date        2023-08-01
- * @brief       外部中断 驱动代码
- * @license     Copyright (c) 2020-2032, 广州市星翼电子科技有限公司
- ****************************************************************************************************
- * @attention
+ * @file  exti.h
+ * @brief 外部中断边沿事件：PA8（LED_Pin）上升沿与 PC13（KEY_Pin）双边沿
  *
- * 实验平台:正点原子 M48Z-M3最小系统板STM32F103版
- * 在线视频:www.yuanzige.com
- * 技术论坛:www.openedv.com
- * 公司网址:www.alientek.com
- * 购买地址:openedv.taobao.com
+ * HAL_GPIO_EXTI_Callback（exti.cpp）在中断中把边沿压入单生产者单消费者队列（spsc_ring.hpp），
+ * 主循环的 Task_Input 取出。
  *
- ****************************************************************************************************
+ * 本模块没有自己的休眠入口，"无事时内核休眠、边沿到来即唤醒" 完全依赖调度器的空闲路径：
+ * SCHED_Run 无就绪任务时调用 SCHED_Idle（main.c 中替换为 TICKLESS_Idle，最终经 LOAD_Wfi 执行 WFI），
+ * EXTI 中断唤醒 WFI。按键边沿经 KEY_OnEdge 使无滴答休眠提前结束、恢复 1ms 时基进行消抖；
+ * PA8 边沿只唤醒并入队，不结束休眠，由 Task_Input 在下一个 10ms 周期取出。
+ * 修改空闲路径时须保留这两点，否则边沿要等到下一次定时唤醒才会被处理。
  */
-
-#ifndef BSP_EXTI_EXTI_H_
-#define BSP_EXTI_EXTI_H_
+#ifndef __EXTI_H
+#define __EXTI_H
 
 #include "main.h"
 
-#endif /* BSP_EXTI_EXTI_H_ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 边沿事件队列长度，须为 2 的幂
+#define EXTI_QUEUE_SIZE 16      // SpscRing 容量；队列满而丢弃的事件数记入指标 exti_dropped
+
+// 一次外部中断边沿
+typedef struct {
+    uint16_t pin;       // 触发的引脚（LED_Pin 即 PA8，KEY_Pin 即 PC13）
+    uint8_t level;      // 中断时的引脚电平
+    uint32_t tick;      // 中断时的 HAL_GetTick()
+} EXTI_Event;
+
+/**
+ * @brief 取出一个边沿事件，不阻塞
+ * @retval 1 取到事件；0 队列为空
+ */
+uint8_t EXTI_GetEvent(EXTI_Event *event);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __EXTI_H
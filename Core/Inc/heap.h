@@ -0,0 +1,73 @@
+#ifndef __HEAP_H
+#define __HEAP_H
+
+#include "main.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 堆统计：newlib 的 malloc 只在需要扩展堆时才调用 _sbrk（sysmem.c），这里在 _sbrk 中记录
+ * 调用次数、堆顶峰值（HEAP_Stats 各项即指标块中的 heap_* 指标，见 metrics.h），
+ * 以及前 HEAP_TRACE_DEPTH 次调用的调用栈。
+ * 工程不使用帧指针，调用栈靠从当前 SP 向上扫描看似 Thumb 返回地址的字得到（奇数且落在
+ * .text 内），每条记录保留前 HEAP_CALLER_DEPTH 个，用 addr2line -e DEV.elf 还原，
+ * 通常依次为 _sbrk_r、_malloc_r、newlib 内部函数（如 _svfprintf_r）和应用代码。
+ *
+ * 初始化完成后调用 HEAP_Seal，之后稳态循环中的 _sbrk 都计入 sealed_calls；
+ * 以 -DHEAP_STRICT=1 编译时改为立即报错，用于证明主循环不分配内存：先记一条 LOG_ERROR
+ * （含 _sbrk 参数与前三个疑似返回地址），再执行未定义指令进入 UsageFault，由 crash.h 保存现场
+ * 并复位；参数与返回地址此时在 r0–r3 中，下次启动 CRASH_Report 的 "crash: r0 ..." 一行即为它们，
+ * pc 指向 sysmem.c 的 heap_trap。
+ */
+#ifndef HEAP_STRICT
+#define HEAP_STRICT 0
+#endif
+
+#define HEAP_TRACE_DEPTH  8u
+#define HEAP_CALLER_DEPTH 4u
+
+typedef struct {
+    uint32_t calls;         // _sbrk 调用次数
+    uint32_t failures;      // 超过栈底被拒绝的次数
+    uint32_t sealed_calls;  // HEAP_Seal 之后的调用次数
+    uint32_t brk;           // 当前堆大小（堆顶 - _end），字节
+    uint32_t brk_peak;      // 堆大小峰值
+} HEAP_Stats;
+
+typedef struct {
+    int32_t incr;                           // _sbrk 参数
+    uint32_t callers[HEAP_CALLER_DEPTH];    // 疑似返回地址，未找到的为 0
+} HEAP_Trace;
+
+// 遥测 TLM_CH_HEAP 的数据（小端），只在调用次数变化时发送
+typedef struct __attribute__((packed)) {
+    HEAP_Stats stats;
+    uint8_t traces;                         // 有效记录数
+    HEAP_Trace trace[HEAP_TRACE_DEPTH];
+} HEAP_Report;
+
+/**
+ * @brief 标记初始化结束，此后的 _sbrk 调用视为稳态分配
+ */
+void HEAP_Seal(void);
+
+void HEAP_GetStats(HEAP_Stats *out);
+
+/**
+ * @brief 第 index 次 _sbrk 调用的记录
+ * @retval 不存在时返回 NULL
+ */
+const HEAP_Trace *HEAP_GetTrace(uint32_t index);
+
+/**
+ * @brief 调用次数有变化时经遥测发送统计与记录，只能在线程上下文调用
+ */
+void HEAP_Dump(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __HEAP_H
@@ -0,0 +1,104 @@
+#ifndef __IRQ_H
+#define __IRQ_H
+
+#include "main.h"
+#include "metrics.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 中断优先级规划（NVIC_PRIORITYGROUP_2：抢占 0–3，子优先级 0–3，数值越小越优先）
+ *
+ *   抢占 0  TIM2      流量输入捕获 + LED 刷新，共用一个中断；不被任何临界区屏蔽
+ *   抢占 1  USART     遥测 DMA 完成（DMA1 通道4）
+ *           EXTI      按键与 PA8 边沿
+ *   抢占 2  ADC       采样完成
+ *           SysTick   HAL 时基、按键消抖、软件定时器
+ *   抢占 3  PendSV    延后工作队列，最低优先级
+ *
+ * 抢占 0 的中断不得调用 IRQ_Lock 保护的接口（SWT_Start 等），只能使用无锁队列和 DEFER_Post。
+ * 各中断的 HAL_NVIC_SetPriority 由 IRQ_Init 按本表统一设置，DEV.ioc 中的值须与本表一致。
+ */
+#define IRQ_PREEMPT_BITS 2u
+
+#define IRQ_PRIO_TIM2       0u
+#define IRQ_SUB_TIM2        0u
+#define IRQ_PRIO_USART      1u
+#define IRQ_SUB_USART       0u
+#define IRQ_PRIO_EXTI       1u
+#define IRQ_SUB_EXTI        1u
+#define IRQ_PRIO_ADC        2u
+#define IRQ_SUB_ADC         1u
+#define IRQ_PRIO_SYSTICK    2u
+#define IRQ_SUB_SYSTICK     0u   // HAL_InitTick 固定使用子优先级 0
+#define IRQ_PRIO_PENDSV     3u
+#define IRQ_SUB_PENDSV      3u
+
+#if TICK_INT_PRIORITY != IRQ_PRIO_SYSTICK
+#error "stm32f1xx_hal_conf.h 的 TICK_INT_PRIORITY 须等于 IRQ_PRIO_SYSTICK"
+#endif
+
+// 屏蔽抢占优先级 ≥ preempt 的中断所需的 BASEPRI 值；preempt 为 0 时 BASEPRI=0 不屏蔽任何中断
+#define IRQ_BASEPRI(preempt) ((uint32_t)(preempt) << (8u - IRQ_PREEMPT_BITS))
+
+/*
+ * 调试构建统计最长的最外层临界区（CPU 周期），记入指标 irq_lock_max_cycles（metrics.h）。
+ * TIM2（刷新，以及将来的流量捕获）为抢占 0，BASEPRI 临界区从不屏蔽它，本值不影响其延迟；
+ * TIM2 的入口延迟由 irqlat.h 直接测量（TLM_CH_IRQLAT）。本值界定的是抢占 1–3 的中断：
+ * 最坏延迟 ≈ 本值 + 同级及更高优先级中断的最长执行时间（isrprof.h）。
+ */
+#ifndef IRQ_LOCK_STATS
+#ifdef DEBUG
+#define IRQ_LOCK_STATS 1
+#else
+#define IRQ_LOCK_STATS 0
+#endif
+#endif
+
+#if IRQ_LOCK_STATS
+extern uint32_t irq_lock_start;
+METRIC_EXTERN_GAUGE(irq_lock_max_cycles);
+#endif
+
+/**
+ * @brief 进入临界区：屏蔽抢占优先级数值 ≥ level 的中断，更高优先级的中断（至少 TIM2）不受影响
+ *        可嵌套，只会提高屏蔽级别；level 须为 1–3
+ * @retval 进入前的 BASEPRI，传给 IRQ_Unlock
+ */
+static inline uint32_t IRQ_Lock(uint32_t level)
+{
+    uint32_t prev = __get_BASEPRI();
+    __set_BASEPRI_MAX(IRQ_BASEPRI(level));
+#if IRQ_LOCK_STATS
+    if (prev == 0) {
+        irq_lock_start = DWT->CYCCNT;
+    }
+#endif
+    return prev;
+}
+
+static inline void IRQ_Unlock(uint32_t prev)
+{
+#if IRQ_LOCK_STATS
+    if (prev == 0) {
+        uint32_t cycles = DWT->CYCCNT - irq_lock_start;
+        if (cycles > (uint32_t)metric_irq_lock_max_cycles) {
+            METRIC_SET(irq_lock_max_cycles, cycles);
+        }
+    }
+#endif
+    __set_BASEPRI(prev);
+}
+
+/**
+ * @brief 按优先级规划设置所有用到的中断，在各 MX_xxx_Init 之后调用
+ */
+void IRQ_Init(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __IRQ_H
@@ -0,0 +1,112 @@
+#ifndef __IRQLAT_H
+#define __IRQLAT_H
+
+#include "main.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 定时器中断延迟与抖动测量（TIM2 更新事件，即 LED 刷新）
+ *
+ * 在 TIM2_IRQHandler 中调用 LAT_TIMER_ENTRY(TIM2)：更新时 CNT 归零，入口处的 CNT 即事件到入口
+ * 经过的计数（10us 分辨率）；另用 DWT 周期数比较相邻两次入口的间隔与该时间片的编程长度
+ * (ARR+1)×(PSC+1)，TIM2 与内核同为 72MHz，差值就是入口延迟的变化，累加得到周期级的相对延迟。
+ * 流量输入捕获尚未接入 TIM2（CC2IE 从未开启），接入后与更新事件共用本中断、同一优先级，
+ * 入口延迟与这里测得的一致。
+ * 相对延迟最大的几次记入最坏情况记录，附被打断处的 PC、当时活动的中断与正在运行的任务。
+ * LAT_Stats 各项同时在指标块中（metrics.h，lat_* 指标），最坏情况记录只经 LAT_Dump 发送。
+ * 调试构建默认开启（同 PROF_ENABLE），发布构建中入口宏为空。
+ */
+#ifndef LAT_ENABLE
+#if defined(DEBUG) && !defined(NDEBUG)
+#define LAT_ENABLE 1
+#else
+#define LAT_ENABLE 0
+#endif
+#endif
+
+// 保留的最坏情况记录数
+#define LAT_TRACE_DEPTH 4
+
+typedef enum {
+    LAT_SRC_UPDATE = 0,     // 更新事件（LED 刷新）
+    LAT_SRC_COUNT
+} LAT_Source;
+
+typedef struct {
+    uint32_t count;
+    uint32_t ticks_max;     // 事件到入口的最大计数（定时器计数）
+    uint32_t ticks_total;
+    int32_t interval_min;   // 相邻入口间隔 - 编程间隔（周期）
+    int32_t interval_max;
+    uint32_t spread;        // 相对延迟的峰峰值（周期），即入口抖动
+    uint32_t resyncs;       // 间隔超过 1.5 个时间片（丢失更新）后重新同步的次数
+} LAT_Stats;
+
+typedef struct {
+    uint64_t when;          // MONO_Cycles
+    uint32_t late;          // 相对本次测量以来最早入口晚了多少周期
+    uint32_t pc;            // 被打断处的 PC，取不到时为 0
+    uint32_t active;        // 入口时处于活动状态（被抢占）的外部中断，NVIC->IABR[0]
+    const char *task;       // 正在运行的调度任务，无则为 NULL
+    uint16_t ticks;
+    uint8_t source;         // LAT_Source
+} LAT_Trace;
+
+// 遥测 TLM_CH_IRQLAT / TLM_CH_IRQLAT_TRACE 的数据（小端），LAT_Dump 每次发送全部来源的统计与最坏情况记录
+typedef struct __attribute__((packed)) {
+    uint8_t source;
+    uint32_t count;
+    uint32_t ticks_max;
+    uint32_t ticks_mean_q8;             // 平均计数 ×256
+    int32_t interval_min;
+    int32_t interval_max;
+    uint32_t spread;
+    uint32_t resyncs;
+} LAT_Report;
+
+typedef struct __attribute__((packed)) {
+    uint8_t rank;                       // 0 为最坏
+    uint8_t source;
+    uint16_t ticks;
+    uint32_t late;
+    uint32_t pc;
+    uint32_t active;
+    uint64_t when;
+    char task[8];                       // 不足补 0
+} LAT_TraceReport;
+
+#if LAT_ENABLE
+/*
+ * 须在中断处理函数中直接展开：与 CRASH_CAPTURE 相同，异常入栈帧取自处理函数入口处的 SP
+ * （__builtin_dwarf_cfa），EXC_RETURN 取自入口处的 LR，不受处理函数序言压栈影响
+ */
+#define LAT_TIMER_ENTRY(tim) \
+    LAT_TimerEntry((tim), (const uint32_t *)__builtin_dwarf_cfa(), (uint32_t)__builtin_return_address(0))
+void LAT_TimerEntry(TIM_TypeDef *tim, const uint32_t *frame, uint32_t exc_return);
+#else
+#define LAT_TIMER_ENTRY(tim) ((void)0)
+#endif
+
+HAL_StatusTypeDef LAT_GetStats(LAT_Source source, LAT_Stats *out);
+
+/**
+ * @brief 取第 rank 坏的记录（0 最坏）
+ * @retval HAL_OK；无此记录或未开启时返回 HAL_ERROR
+ */
+HAL_StatusTypeDef LAT_GetTrace(uint8_t rank, LAT_Trace *out);
+
+void LAT_Reset(void);
+
+/**
+ * @brief 经遥测发送统计与最坏情况记录，只能在线程上下文调用
+ */
+void LAT_Dump(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __IRQLAT_H
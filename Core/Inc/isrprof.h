@@ -0,0 +1,103 @@
+#ifndef __ISRPROF_H
+#define __ISRPROF_H
+
+#include "main.h"
+#include "trace.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 中断耗时统计：在 stm32f1xx_it.c 的各处理函数首尾用 PROF_ENTER/PROF_EXIT 读取 DWT->CYCCNT，
+ * 记录每个处理函数的次数、最短、最长、平均耗时（CPU 周期）与对数-线性直方图。
+ * 耗时为独占时间：被更高优先级中断抢占的部分已扣除。
+ * 次数、最短与最长耗时同时在指标块中（metrics.h，isr_<名称>_count/_min/_max），
+ * 平均值与直方图只经 PROF_Dump 发送。
+ * 调试构建（定义 DEBUG 且未定义 NDEBUG）默认开启，发布构建中两个宏为空，不占 RAM 与周期。
+ * 两个宏同时产生 trace.h 的中断进入/退出事件（由 TRACE_ENABLE 单独控制）。
+ */
+#ifndef PROF_ENABLE
+#if defined(DEBUG) && !defined(NDEBUG)
+#define PROF_ENABLE 1
+#else
+#define PROF_ENABLE 0
+#endif
+#endif
+
+typedef enum {
+    PROF_SYSTICK = 0,
+    PROF_TIM2,
+    PROF_EXTI9_5,
+    PROF_EXTI15_10,
+    PROF_PENDSV,
+    PROF_DMA1_CH4,
+    PROF_ADC,
+    PROF_COUNT
+} PROF_Id;
+
+// 直方图：每个 2 的幂区间分 2 格，桶 b 覆盖 [2^(b/2) × (1 + (b&1)/2), ...)，最后一格收纳更长的
+#define PROF_HIST_BUCKETS 40
+
+typedef struct {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t total;
+    uint16_t hist[PROF_HIST_BUCKETS];   // 饱和计数
+} PROF_Stats;
+
+// 遥测 TLM_CH_ISRPROF 的数据（小端）
+typedef struct __attribute__((packed)) {
+    uint8_t id;                         // PROF_Id
+    uint8_t buckets;                    // PROF_HIST_BUCKETS
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint32_t mean;
+    uint16_t hist[PROF_HIST_BUCKETS];
+} PROF_Report;
+
+#if PROF_ENABLE
+
+extern volatile uint32_t prof_nested;
+
+// 须放在处理函数开头（声明局部变量）
+#define PROF_ENTER(id)                              \
+    uint32_t prof_start_ = DWT->CYCCNT;             \
+    uint32_t prof_base_ = prof_nested;              \
+    TRACE_ISR_ENTER(id)
+
+#define PROF_EXIT(id)                               \
+    do {                                            \
+        TRACE_ISR_EXIT(id);                         \
+        PROF_Record((id), prof_start_, prof_base_); \
+    } while (0)
+
+void PROF_Record(PROF_Id id, uint32_t start, uint32_t nested_base);
+
+#else
+
+#define PROF_ENTER(id) TRACE_ISR_ENTER(id)
+#define PROF_EXIT(id)  TRACE_ISR_EXIT(id)
+
+#endif
+
+/**
+ * @brief 取一个处理函数的统计快照
+ * @retval HAL_OK；未开启 PROF_ENABLE 或 id 无效时返回 HAL_ERROR
+ */
+HAL_StatusTypeDef PROF_GetStats(PROF_Id id, PROF_Stats *out);
+
+void PROF_Reset(void);
+
+/**
+ * @brief 经遥测链路发送全部处理函数的快照（每个一帧），只能在线程上下文调用
+ */
+void PROF_Dump(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __ISRPROF_H
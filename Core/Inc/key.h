@@ -3,6 +3,57 @@
 
 #include "main.h"
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 消抖积分器上限（ms）：连续按下/松开累计达到该值才翻转状态
+#define KEY_DEBOUNCE_MS  5
+// 按住多久产生长按事件（ms）
+#define KEY_LONG_MS      800
+// 长按后每隔多久产生一次连发事件（ms）
+#define KEY_REPEAT_MS    200
+// 事件队列长度，须为 2 的幂
+#define KEY_QUEUE_SIZE   8
+
+typedef enum {
+    KEY_EVENT_NONE = 0,
+    KEY_EVENT_PRESS,        // 按下（消抖后）
+    KEY_EVENT_RELEASE,      // 松开（消抖后）
+    KEY_EVENT_LONG,         // 按住 KEY_LONG_MS
+    KEY_EVENT_REPEAT        // 长按后每 KEY_REPEAT_MS 一次
+} KEY_Event;
+
+/**
+ * @brief 1ms 采样一次按键（PC13）并推进消抖状态机，在 SysTick 中断中调用
+ *        按键稳定松开后状态机休眠，直到 KEY_OnEdge 再次唤醒
+ */
+void KEY_Tick(void);
+
+/**
+ * @brief 按键引脚出现边沿，在 EXTI 中断中调用
+ */
+void KEY_OnEdge(void);
+
+/**
+ * @brief 消抖状态机是否在休眠（稳定松开），休眠时 KEY_Tick 可以暂停
+ */
+uint8_t KEY_IsIdle(void);
+
+/**
+ * @brief 取出一个按键事件，不阻塞
+ * @retval 队列为空时返回 KEY_EVENT_NONE
+ */
+KEY_Event KEY_GetEvent(void);
+
+/**
+ * @brief 消抖后的按键状态，不阻塞
+ * @retval 1 按下；0 松开
+ */
 uint8_t KEY_GetState(void);
 
+#ifdef __cplusplus
+}
+#endif
+
 #endif
@@ -1,30 +1,94 @@
 #ifndef __LED_H
 #define __LED_H
 
-#include "stm32f1xx_hal.h"
+#include "main.h"
 
-// 显示行数（PB6–PB11 控制 LED 行，共6行）
-#define LED_ROWS 6
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 显存最大行列数（vram 每个元素 8 位，对应最多 8 列）
+#define LED_MAX_ROWS 8
+#define LED_MAX_COLS 8
+
+// 默认几何：列 LED1–LED8（PB0–PB7）接数码管段 a–g、dp，行 LED9–LED14（PB8–PB13）接6位位选
+#define LED_DEFAULT_COL_PINS LED1_Pin, LED2_Pin, LED3_Pin, LED4_Pin, \
+                             LED5_Pin, LED6_Pin, LED7_Pin, LED8_Pin
+#define LED_DEFAULT_ROW_PINS LED9_Pin, LED10_Pin, LED11_Pin, LED12_Pin, \
+                             LED13_Pin, LED14_Pin
+
+// BCM（二进制编码调制）位平面数，共 2^LED_BCM_BITS 级亮度
+#define LED_BCM_BITS       3
+#define LED_BRIGHTNESS_MAX ((1u << LED_BCM_BITS) - 1u)
+
+// 最低位平面的点亮时间（TIM2 计数值，72MHz/720 → 10us），位平面 b 点亮 LED_BCM_UNIT_TICKS << b
+// 默认 100us，每行 700us，6行一帧约 238Hz。注意 ARR 为 0 时计数器停止，该值至少为 2
+#ifndef LED_BCM_UNIT_TICKS
+#define LED_BCM_UNIT_TICKS 10u
+#endif
+
+// 每帧最大时间片数：每行 LED_BCM_BITS 个时间片
+#define LED_MAX_SLICES (LED_MAX_ROWS * LED_BCM_BITS)
+
+// 显示几何描述：行列引脚须在同一端口，vram[r] 的第 c 位对应 row_pins[r] 与 col_pins[c] 交点
+typedef struct {
+    GPIO_TypeDef *port;
+    const uint16_t *row_pins;
+    const uint16_t *col_pins;
+    uint8_t rows;               // 1–LED_MAX_ROWS
+    uint8_t cols;               // 1–LED_MAX_COLS
+    uint8_t row_active_high;    // 1：行引脚输出高电平时选通；0：低电平选通
+    uint8_t col_active_high;    // 1：列引脚输出高电平时点亮；0：低电平点亮
+} LED_Geometry;
+
+extern const LED_Geometry LED_DefaultGeometry;
 
 // 用户应写入的显存（每个元素为一个行的列亮灭状态）
-extern uint8_t vram[LED_ROWS];
+extern uint8_t vram[LED_MAX_ROWS];
 
 /**
- * @brief 初始化 LED 显示所需的 GPIOB 引脚（PB0–PB15）
- *        PB0–PB5 为列控制输出，PB6–PB15 为行控制输出
+ * @brief 按几何描述生成行列的 BSRR 掩码，并将所有行列置为熄灭
+ * @param geometry 几何描述，NULL 使用 LED_DefaultGeometry；须在整个运行期间有效
+ * @retval HAL_OK；行列数超出范围时返回 HAL_ERROR
  */
-void LED_Init(void);
+HAL_StatusTypeDef LED_Init(const LED_Geometry *geometry);
 
 /**
- * @brief 启动 LED 刷新定时器中断（需要用户在 main.c 中初始化 TIM14）
+ * @brief 启动 LED 刷新定时器中断（定时器需已由 MX_TIMx_Init 初始化并开启 ARR 预装载）
+ * @param htim 刷新定时器句柄，本工程为 htim2
  */
-void LED_Start(void);
+HAL_StatusTypeDef LED_Start(TIM_HandleTypeDef *htim);
 
 /**
  * @brief 定时器中断回调处理函数
  *        需要在 HAL_TIM_PeriodElapsedCallback 中调用本函数
- * @param htim HAL定时器句柄
+ * @param htim HAL定时器句柄，非 LED_Start 传入的定时器时直接返回
  */
 void LED_UpdateDisplay(TIM_HandleTypeDef *htim);
 
+/**
+ * @brief 设置整帧亮度（0 = 熄灭，LED_BRIGHTNESS_MAX = 最亮）
+ *        在下一次 LED_Present 时生效
+ */
+void LED_SetBrightness(uint8_t level);
+
+uint8_t LED_GetBrightness(void);
+
+/**
+ * @brief 设置单个 LED 的亮度（0–LED_BRIGHTNESS_MAX），默认最亮
+ *        实际亮度 = 单点亮度 × 整帧亮度 / LED_BRIGHTNESS_MAX
+ * @retval HAL_OK；行列超出 LED_Init 配置的点阵（含尚未初始化）时返回 HAL_ERROR
+ */
+HAL_StatusTypeDef LED_SetLevel(uint8_t row, uint8_t col, uint8_t level);
+
+/**
+ * @brief 将 vram 编码为 BCM 时间片帧并提交给刷新中断，在下一帧开始时切换
+ * @retval HAL_OK 已提交；HAL_BUSY 上一帧尚未被刷新中断取走，本次未提交
+ */
+HAL_StatusTypeDef LED_Present(void);
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif // __LED_H
@@ -0,0 +1,121 @@
+#ifndef __LOG_H
+#define __LOG_H
+
+#include "main.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 延迟格式化的二进制日志：日志点只把格式串 ID、DWT 时间戳和最多 LOG_MAX_ARGS 个 32 位参数
+ * 写入字环，格式化在主机上完成（Tools/logdec）。
+ *
+ * 格式串（"级别|文件:行|格式"）放在 .log_fmt 段，链接脚本把它定位在地址 0 且不装载
+ * （INFO），只存在于 DEV.elf 中，不占 Flash；格式串的地址即段内偏移，用作 16 位 ID。
+ *
+ * 记录格式（32 位字，小端）：
+ *   [0] ID | 参数个数 << 16
+ *   [1] DWT->CYCCNT
+ *   [2..] 参数
+ * 写入时只关 PRIMASK 十几条指令，任意中断和线程都可调用。
+ * 参数一律按 32 位传递：%d/%i 有符号，%u/%x/%c 无符号，%f/%e/%g 须用 LOG_F() 包装，
+ * 不支持 %s（字符串内容不在记录中）。同一行只能有一个日志点。
+ */
+#define LOG_RING_WORDS 256u     // 2 的幂
+#define LOG_MAX_ARGS   4u
+
+#define LOG_LEVEL_ERROR 0
+#define LOG_LEVEL_WARN  1
+#define LOG_LEVEL_INFO  2
+#define LOG_LEVEL_DEBUG 3
+
+// 编译期过滤，高于该级别的日志点不生成代码
+#ifndef LOG_LEVEL
+#if defined(DEBUG) && !defined(NDEBUG)
+#define LOG_LEVEL LOG_LEVEL_DEBUG
+#else
+#define LOG_LEVEL LOG_LEVEL_INFO
+#endif
+#endif
+
+/*
+ * 统计在指标块中（metrics.h）：
+ *   log_records  已写入的记录数
+ *   log_dropped  字环已满而丢弃的记录数
+ *   log_frames   已发送的遥测帧数
+ */
+
+/*
+ * 遥测 TLM_CH_LOG 的数据（小端）：uint32 累计丢弃数，随后是若干条完整记录。
+ * 主机发现丢弃数增加时即可提示中间有缺失。
+ */
+
+#define LOG_STR_(x) #x
+#define LOG_STR(x)  LOG_STR_(x)
+
+#define LOG_NARGS_(_0, _1, _2, _3, _4, n, ...) n
+#define LOG_NARGS(...) LOG_NARGS_(0, ##__VA_ARGS__, 4, 3, 2, 1, 0)
+
+// 参数多于 LOG_MAX_ARGS 个时 LOG_NARGS 会取到调用者的第 5 个参数而不是个数，记录头随之错乱，
+// 这里按初始化列表长度在编译期拦下
+#define LOG_CHECK_NARGS(...) \
+    _Static_assert(sizeof((uint32_t[]){0, ##__VA_ARGS__}) <= (1u + LOG_MAX_ARGS) * sizeof(uint32_t), \
+                   "LOG_* takes at most 4 arguments")
+
+#define LOG_RECORD(tag, fmt, ...) \
+    do { \
+        LOG_CHECK_NARGS(__VA_ARGS__); \
+        static const char log_fmt_[] __attribute__((section(".log_fmt"), used)) = \
+            tag "|" __FILE__ ":" LOG_STR(__LINE__) "|" fmt; \
+        LOG_Write((const uint32_t[1u + LOG_MAX_ARGS]){ \
+            ((uint32_t)(uintptr_t)log_fmt_ & 0xFFFFu) | ((uint32_t)LOG_NARGS(__VA_ARGS__) << 16), ##__VA_ARGS__}); \
+    } while (0)
+
+#if LOG_LEVEL >= LOG_LEVEL_ERROR
+#define LOG_ERROR(fmt, ...) LOG_RECORD("E", fmt, ##__VA_ARGS__)
+#else
+#define LOG_ERROR(fmt, ...) ((void)0)
+#endif
+#if LOG_LEVEL >= LOG_LEVEL_WARN
+#define LOG_WARN(fmt, ...) LOG_RECORD("W", fmt, ##__VA_ARGS__)
+#else
+#define LOG_WARN(fmt, ...) ((void)0)
+#endif
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+#define LOG_INFO(fmt, ...) LOG_RECORD("I", fmt, ##__VA_ARGS__)
+#else
+#define LOG_INFO(fmt, ...) ((void)0)
+#endif
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(fmt, ...) LOG_RECORD("D", fmt, ##__VA_ARGS__)
+#else
+#define LOG_DEBUG(fmt, ...) ((void)0)
+#endif
+
+// float 参数按位传递
+static inline uint32_t LOG_F(float value)
+{
+    union {
+        float f;
+        uint32_t u;
+    } bits = {.f = value};
+    return bits.u;
+}
+
+/**
+ * @brief 写入一条记录，由 LOG_* 宏调用
+ * @param rec rec[0] 为 ID 与参数个数，其后为参数
+ */
+void LOG_Write(const uint32_t *rec);
+
+/**
+ * @brief 把字环中的完整记录打包经遥测发送，直到取空或发送环已满，只能在线程上下文调用
+ */
+void LOG_Flush(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __LOG_H
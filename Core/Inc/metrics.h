@@ -0,0 +1,99 @@
+#ifndef __METRICS_H
+#define __METRICS_H
+
+#include "main.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 指标注册表：计数器、仪表和直方图在定义处静态注册，全部放在 .bss 中一段连续的
+ * .bss.__metrics 块里（链接脚本中 _smetrics 到 _emetrics），由启动代码清零。
+ * METRIC_Dump 关中断拷贝整块后经遥测一次发出，主机按 ELF 中的模式解析。
+ *
+ * 每个指标在不装载的 .metrics_schema 段（与 .log_fmt 一样只存在于 DEV.elf）中有一条
+ * METRIC_Desc，记录名称、类型和变量地址；快照帧带有块的起始地址，主机据此求偏移。
+ *
+ * 更新：
+ *   METRIC_SET    仪表，一条 STR
+ *   METRIC_INC/ADD 计数器，LDR/ADD/STR，只能由一个上下文（或同一抢占优先级）写入
+ *   METRIC_INC_ATOMIC 多个优先级都会写的计数器，LDREX/STREX
+ *   METRIC_OBSERVE 直方图，CLZ 求桶号后加一，同样只能单一上下文写入
+ * 直方图第 0 桶计数值 0，第 i 桶计数 [2^(i-1), 2^i)，最后一桶兼收更大的值。
+ */
+#define METRIC_NAME_LEN 24u     // 名称（不含 metric_ 前缀）最长 24 个字符，超长时编译器告警
+#define METRIC_BLOCK_MAX 512u   // 块大小上限（字节），链接脚本中的 ASSERT 须与之一致
+
+typedef enum {
+    METRIC_TYPE_COUNTER = 1,    // uint32_t
+    METRIC_TYPE_GAUGE,          // int32_t
+    METRIC_TYPE_HISTOGRAM,      // uint32_t[count]
+} METRIC_Type;
+
+// 模式条目，目标机上 32 字节
+typedef struct {
+    const volatile void *addr;
+    uint8_t type;               // METRIC_Type
+    uint8_t count;              // 直方图桶数，其他为 1
+    uint8_t reserved[2];
+    char name[METRIC_NAME_LEN];
+} METRIC_Desc;
+
+// 遥测 TLM_CH_METRICS 的帧头（小端），其后是块中 [offset, offset + 本帧长度) 的数据
+typedef struct __attribute__((packed)) {
+    uint32_t base;              // 块起始地址（_smetrics）
+    uint32_t sequence;          // 快照序号，同一快照的各帧相同
+    uint16_t offset;
+    uint16_t total;             // 块大小
+} METRIC_Header;
+
+// 条目显式按自身对齐，避免编译器为大对象加大对齐而在段内留下空隙
+#define METRIC_SCHEMA_(name, t, n) \
+    static const METRIC_Desc metric_##name##_desc_ \
+        __attribute__((section(".metrics_schema"), aligned(__alignof__(METRIC_Desc)), used)) = \
+        {&metric_##name, (uint8_t)(t), (uint8_t)(n), {0, 0}, #name}
+
+#define METRIC_STORAGE __attribute__((section(".bss.__metrics")))
+
+// 定义指标，在文件作用域使用；变量名为 metric_<name>，其他文件用 METRIC_EXTERN_* 声明后更新
+#define METRIC_COUNTER(name) \
+    METRIC_STORAGE volatile uint32_t metric_##name; \
+    METRIC_SCHEMA_(name, METRIC_TYPE_COUNTER, 1)
+#define METRIC_GAUGE(name) \
+    METRIC_STORAGE volatile int32_t metric_##name; \
+    METRIC_SCHEMA_(name, METRIC_TYPE_GAUGE, 1)
+#define METRIC_HISTOGRAM(name, buckets) \
+    METRIC_STORAGE volatile uint32_t metric_##name[buckets]; \
+    METRIC_SCHEMA_(name, METRIC_TYPE_HISTOGRAM, buckets)
+
+#define METRIC_EXTERN_COUNTER(name)            extern volatile uint32_t metric_##name
+#define METRIC_EXTERN_GAUGE(name)              extern volatile int32_t metric_##name
+#define METRIC_EXTERN_HISTOGRAM(name, buckets) extern volatile uint32_t metric_##name[buckets]
+
+#define METRIC_INC(name)        (metric_##name++)
+#define METRIC_ADD(name, n)     (metric_##name += (uint32_t)(n))
+#define METRIC_INC_ATOMIC(name) ((void)__atomic_fetch_add(&metric_##name, 1u, __ATOMIC_RELAXED))
+#define METRIC_SET(name, v)     (metric_##name = (int32_t)(v))
+#define METRIC_OBSERVE(name, v) \
+    METRIC_Observe(metric_##name, sizeof(metric_##name) / sizeof(metric_##name[0]), (v))
+
+static inline void METRIC_Observe(volatile uint32_t *hist, uint32_t buckets, uint32_t value)
+{
+    uint32_t i = value ? 32u - (uint32_t)__builtin_clz(value) : 0u;
+    if (i >= buckets) {
+        i = buckets - 1u;
+    }
+    hist[i]++;
+}
+
+/**
+ * @brief 关中断拷贝整块指标并经遥测发送，块超过一帧时拆成多帧，只能在线程上下文调用
+ */
+void METRIC_Dump(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __METRICS_H
@@ -0,0 +1,62 @@
+#ifndef __MONO_H
+#define __MONO_H
+
+/*
+ * 64 位单调时钟：目标板上取 DWT->CYCCNT（72MHz，约 59.6s 回绕一次）并在软件中扩展高 32 位；
+ * 主机上（非 ARM 编译）改用 CLOCK_MONOTONIC 换算成同样的周期数，使用本模块的代码可在 Linux 上测试。
+ * 本头文件只依赖 <stdint.h>，主机编译不需要 HAL。
+ */
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 时钟频率，须与 SystemClock_Config 的 HCLK 一致，MONO_Init 会检查
+#define MONO_CPU_HZ 72000000u
+
+/**
+ * @brief 开启 DWT 周期计数器（主机上只记录起点），在 SystemClock_Config 之后立即调用：
+ *        冷上电且未接调试器时 CYCCNT 不运行，此前所有 DWT->CYCCNT 读数都是 0
+ * @retval 0 成功；-1 SystemCoreClock 与 MONO_CPU_HZ 不一致
+ */
+int MONO_Init(void);
+
+/**
+ * @brief 自 MONO_Init 起的 CPU 周期数，可在任意上下文调用
+ *        两次调用的间隔不得超过一次回绕（约 59s），SysTick 中调用 MONO_Tick 保证这一点
+ */
+uint64_t MONO_Cycles(void);
+
+// 防止长时间无人读取时错过回绕，在 SysTick 中调用
+static inline void MONO_Tick(void)
+{
+    (void)MONO_Cycles();
+}
+
+static inline uint64_t MONO_CyclesToUs(uint64_t cycles)
+{
+    return cycles / (MONO_CPU_HZ / 1000000u);
+}
+
+static inline uint64_t MONO_CyclesToNs(uint64_t cycles)
+{
+    // 72MHz 下 1 周期 = 125/9 ns，先乘后除保持精度，2^64 / 125 周期约 65 年不会溢出
+    return cycles * 125u / 9u;
+}
+
+static inline uint64_t MONO_Us(void)
+{
+    return MONO_CyclesToUs(MONO_Cycles());
+}
+
+static inline uint64_t MONO_Ns(void)
+{
+    return MONO_CyclesToNs(MONO_Cycles());
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __MONO_H
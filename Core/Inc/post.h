@@ -0,0 +1,61 @@
+#ifndef __POST_H
+#define __POST_H
+
+#include "main.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 上电自测（POST）性能基准：用固定输入在关中断下以 DWT 计时关键路径，每个取 POST_ROUNDS 次
+ * 中的最大值（扣除计时本身的开销），写入指标块（post_*_cycles 仪表、post_fail_mask），
+ * 超过编译进固件的阈值时记 LOG_WARN。用于 HAL 或编译器升级后确认热点没有变慢。
+ *
+ * 阈值是按算法估计并留出约 2 倍余量的初值，上板后应按实测值收紧；可在编译时覆盖。
+ */
+#ifndef POST_ENABLE
+#define POST_ENABLE 1
+#endif
+
+#define POST_ROUNDS 8u
+
+#ifndef POST_LIMIT_NTC
+#define POST_LIMIT_NTC     12000u   // NTC_ConvertToCelsius，软浮点 log()
+#endif
+#ifndef POST_LIMIT_FORMAT
+#define POST_LIMIT_FORMAT  2000u    // SEG7_FormatFixed，3 位定点数
+#endif
+#ifndef POST_LIMIT_ENCODE
+#define POST_LIMIT_ENCODE  6000u    // LED_Present，全部段点亮的整帧 BCM 编码
+#endif
+#ifndef POST_LIMIT_REFRESH
+#define POST_LIMIT_REFRESH 300u     // LED_UpdateDisplay，刷新中断主体
+#endif
+
+typedef enum {
+    POST_NTC = 0,
+    POST_FORMAT,
+    POST_ENCODE,
+    POST_REFRESH,
+    POST_COUNT
+} POST_Kernel;
+
+/**
+ * @brief 运行全部基准，须在 MONO_Init、LED_Start(&htim2) 之后，调度器开始运行之前调用
+ *        期间屏蔽刷新定时器（TIM2）中断并直接调用刷新中断主体，结束后恢复显存并重新提交一帧
+ * @retval 超过阈值的项目位掩码（1 << POST_Kernel），全部通过为 0；CYCCNT 未运行时全部置位；
+ *         POST_ENABLE 为 0 时恒为 0
+ */
+uint32_t POST_Run(void);
+
+/**
+ * @brief 上次 POST_Run 中某项的结果（CPU 周期）
+ */
+uint32_t POST_GetCycles(POST_Kernel kernel);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __POST_H
@@ -0,0 +1,127 @@
+#ifndef __PT_H
+#define __PT_H
+
+/*
+ * 无栈协程（protothread）：用 switch/case 记住函数内的续点，每次调用从上次让出处继续执行。
+ *
+ *   static PT_THREAD(Sample(PT *pt))
+ *   {
+ *       PT_BEGIN(pt);
+ *       while (1) {
+ *           start();
+ *           PT_WAIT_UNTIL(pt, done());
+ *           read();
+ *           PT_SLEEP(pt, 100);
+ *       }
+ *       PT_END(pt);
+ *   }
+ *
+ * 每个协程只占一个 PT 结构，不需要独立的栈；代价是局部变量在让出后不保留，需跨越等待的状态
+ * 须放在 PT 或静态变量中（PT.t0 可作计时用）。续点以行号区分，一行只能写一个等待宏；
+ * 协程体内不能用 switch 语句包住等待宏；C++ 中等待宏不能跨越带初始化的局部变量。
+ *
+ * 协程函数返回 PT_Status，由外层（一般是调度器任务）决定何时再次调用：
+ *   PT_WAITING  条件未满足，尽快再调用（SCHED_Post）
+ *   PT_YIELDED  主动让出一次，尽快再调用
+ *   PT_SLEEPING 休眠 pt->sleep_ms 毫秒后再调用（SCHED_Arm）
+ *   PT_ENDED    执行到 PT_END 或 PT_EXIT，已复位，再次调用从头开始
+ */
+#include <stdint.h>
+
+typedef enum {
+    PT_WAITING = 0,
+    PT_YIELDED,
+    PT_SLEEPING,
+    PT_ENDED
+} PT_Status;
+
+typedef struct {
+    uint16_t lc;        // 续点（行号），0 表示从头开始
+    uint32_t sleep_ms;  // PT_SLEEP 请求的休眠时长
+    uint32_t t0;        // 供协程体保存超时起点等跨等待的状态
+} PT;
+
+#define PT_THREAD(decl) PT_Status decl
+
+#define PT_INIT(pt) ((pt)->lc = 0)
+
+#define PT_BEGIN(pt)                        \
+    {                                       \
+        uint8_t pt_yielded = 1;             \
+        (void)pt_yielded;                   \
+        switch ((pt)->lc) {                 \
+        case 0:
+
+#define PT_END(pt)                          \
+        }                                   \
+        PT_INIT(pt);                        \
+        return PT_ENDED;                    \
+    }
+
+#if defined(__GNUC__) && __GNUC__ >= 7
+#define PT_FALLTHROUGH __attribute__((fallthrough))
+#else
+#define PT_FALLTHROUGH ((void)0)
+#endif
+
+// 续点：记录行号并在下次调用时从此处进入
+#define PT_SET(pt) (pt)->lc = __LINE__; PT_FALLTHROUGH; case __LINE__:
+
+#define PT_WAIT_UNTIL(pt, cond)             \
+    do {                                    \
+        PT_SET(pt)                          \
+        if (!(cond)) {                      \
+            return PT_WAITING;              \
+        }                                   \
+    } while (0)
+
+#define PT_WAIT_WHILE(pt, cond) PT_WAIT_UNTIL(pt, !(cond))
+
+// 让出一次，下次调用从其后继续
+#define PT_YIELD(pt)                        \
+    do {                                    \
+        pt_yielded = 0;                     \
+        PT_SET(pt)                          \
+        if (!pt_yielded) {                  \
+            return PT_YIELDED;              \
+        }                                   \
+    } while (0)
+
+// 休眠 ms 毫秒，由外层按 pt->sleep_ms 延后下次调用
+#define PT_SLEEP(pt, ms)                    \
+    do {                                    \
+        pt_yielded = 0;                     \
+        (pt)->sleep_ms = (ms);              \
+        PT_SET(pt)                          \
+        if (!pt_yielded) {                  \
+            return PT_SLEEPING;             \
+        }                                   \
+    } while (0)
+
+// 运行子协程直到其结束，子协程的让出与休眠原样传给外层
+#define PT_SPAWN(pt, child, thread)                 \
+    do {                                            \
+        PT_INIT(child);                             \
+        PT_SET(pt)                                  \
+        {                                           \
+            PT_Status pt_child = (thread);          \
+            if (pt_child != PT_ENDED) {             \
+                (pt)->sleep_ms = (child)->sleep_ms; \
+                return pt_child;                    \
+            }                                       \
+        }                                           \
+    } while (0)
+
+#define PT_RESTART(pt)                      \
+    do {                                    \
+        PT_INIT(pt);                        \
+        return PT_YIELDED;                  \
+    } while (0)
+
+#define PT_EXIT(pt)                         \
+    do {                                    \
+        PT_INIT(pt);                        \
+        return PT_ENDED;                    \
+    } while (0)
+
+#endif // __PT_H
@@ -0,0 +1,97 @@
+#ifndef __SCHEDULER_H
+#define __SCHEDULER_H
+
+#include "main.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 最多可注册的任务数
+#define SCHED_MAX_TASKS 8
+
+// 调优用的每任务统计
+typedef struct {
+    uint32_t runs;          // 运行次数
+    uint32_t misses;        // 完成时刻晚于截止时间，或因超时跳过的周期数
+    uint32_t cycles_last;   // 上次运行耗时（CPU 周期）
+    uint32_t cycles_max;    // 最长运行耗时
+    uint64_t cycles_total;  // 累计运行耗时
+} SCHED_Stats;
+
+typedef struct {
+    const char *name;
+    void (*run)(void);      // 运行到返回为止，不得阻塞
+    uint32_t period_ms;     // 0 为单次任务
+    uint32_t deadline_ms;   // 相对释放时刻的截止时间，0 表示等于周期（单次任务不检查）
+    uint8_t priority;       // 数值越小越优先，同优先级按截止时间先后（EDF）
+
+    // 以下由调度器维护
+    uint8_t id;             // 注册顺序，用作跟踪事件中的任务编号
+    uint8_t armed;
+    volatile uint8_t posted;
+    uint32_t release;       // 下次释放时刻（HAL_GetTick）
+    SCHED_Stats stats;
+} SCHED_Task;
+
+/**
+ * @brief 初始化调度器，任务耗时取自 MONO_Cycles，须在 MONO_Init 之后调用
+ */
+void SCHED_Init(void);
+
+/**
+ * @brief 注册任务，注册后须用 SCHED_Arm 或 SCHED_Post 安排运行
+ * @retval HAL_OK；任务表已满时返回 HAL_ERROR
+ */
+HAL_StatusTypeDef SCHED_Add(SCHED_Task *task);
+
+/**
+ * @brief 在 delay_ms 后释放任务：周期任务此后按周期重复，单次任务只运行一次
+ *        只能在线程上下文（任务中或主循环）调用
+ */
+void SCHED_Arm(SCHED_Task *task, uint32_t delay_ms);
+
+/**
+ * @brief 取消尚未运行的释放
+ */
+void SCHED_Cancel(SCHED_Task *task);
+
+/**
+ * @brief 请求尽快运行一次任务，可在中断中调用
+ */
+void SCHED_Post(SCHED_Task *task);
+
+/**
+ * @brief 按注册顺序取任务
+ * @retval id 超出已注册的任务数时返回 NULL
+ */
+const SCHED_Task *SCHED_GetTask(uint8_t id);
+
+/**
+ * @brief 正在运行的任务，空闲或在任务之外时为 NULL，可在中断中调用（用于诊断）
+ */
+const SCHED_Task *SCHED_Current(void);
+
+/**
+ * @brief 是否有尚未运行的 SCHED_Post，可在中断中调用
+ */
+uint8_t SCHED_Pending(void);
+
+/**
+ * @brief 调度一轮：运行一个就绪任务，无就绪任务时调用 SCHED_Idle 休眠到下一次中断后返回
+ *        在 main 的 while (1) 中（USER CODE BEGIN 3）反复调用
+ */
+void SCHED_Run(void);
+
+/**
+ * @brief 空闲钩子，调用时中断已关闭（PRIMASK），返回后调度器重新开中断
+ *        弱定义为 LOAD_Wfi（计入 CPU 占用统计的 WFI），可替换为无滴答休眠
+ * @param idle_ms 距最早的任务释放还有多少 ms，没有已安排的任务时为 UINT32_MAX
+ */
+void SCHED_Idle(uint32_t idle_ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __SCHEDULER_H
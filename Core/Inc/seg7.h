@@ -0,0 +1,88 @@
+#ifndef __SEG7_H
+#define __SEG7_H
+
+#include "main.h"
+#include "led.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 数码管段引脚：a–g、dp 接 LED1–LED8，字模表在编译期由此映射生成
+#define SEG7_A_Pin  LED1_Pin
+#define SEG7_B_Pin  LED2_Pin
+#define SEG7_C_Pin  LED3_Pin
+#define SEG7_D_Pin  LED4_Pin
+#define SEG7_E_Pin  LED5_Pin
+#define SEG7_F_Pin  LED6_Pin
+#define SEG7_G_Pin  LED7_Pin
+#define SEG7_DP_Pin LED8_Pin
+
+// 字符编号（字模表下标）
+typedef enum {
+    SEG7_CHAR_0 = 0,            // 0–9 依次为数字
+    SEG7_CHAR_9 = 9,
+    SEG7_CHAR_BLANK,
+    SEG7_CHAR_MINUS,
+    SEG7_CHAR_E,
+    SEG7_CHAR_r,
+    SEG7_CHAR_O,
+    SEG7_CHAR_P,
+    SEG7_CHAR_n,
+    SEG7_CHAR_S,
+    SEG7_CHAR_h,
+    SEG7_CHAR_t,
+    SEG7_CHAR_COUNT
+} SEG7_Char;
+
+// 状态字：---（无数据）、Err、OPn（开路）、Sht（短路）
+typedef enum {
+    SEG7_GLYPH_NONE = 0,
+    SEG7_GLYPH_ERR,
+    SEG7_GLYPH_OPEN,
+    SEG7_GLYPH_SHORT
+} SEG7_Glyph;
+
+// 显示单元 = 字符编号，最高位表示带小数点
+#define SEG7_CELL_DP 0x80u
+
+// 字符 → vram 列位（编译期生成，位于 Flash）
+extern const uint8_t SEG7_Font[SEG7_CHAR_COUNT];
+// 小数点对应的 vram 列位
+extern const uint8_t SEG7_DpBits;
+
+// 单元 → vram 列位，两次查表
+static inline uint8_t SEG7_Encode(uint8_t cell)
+{
+    uint8_t bits = SEG7_Font[cell & (uint8_t)~SEG7_CELL_DP];
+    return (cell & SEG7_CELL_DP) ? (uint8_t)(bits | SEG7_DpBits) : bits;
+}
+
+/**
+ * @brief 将定点数格式化为右对齐的显示单元
+ * @param cells 输出单元，cells[0] 为最左一位
+ * @param width 位数
+ * @param value 定点数值，例如 frac = 1 时 234 显示为 23.4
+ * @param frac  小数位数（0 即整数）
+ * @retval HAL_OK；位数不够时输出 Err 并返回 HAL_ERROR
+ */
+HAL_StatusTypeDef SEG7_FormatFixed(uint8_t *cells, uint8_t width, int32_t value, uint8_t frac);
+
+/**
+ * @brief 将状态字格式化为显示单元，--- 填满整个字段，其余右对齐
+ */
+void SEG7_FormatGlyph(uint8_t *cells, uint8_t width, SEG7_Glyph glyph);
+
+/**
+ * @brief 格式化并写入 vram[row] 起的 width 位
+ */
+HAL_StatusTypeDef SEG7_WriteFixed(uint8_t row, uint8_t width, int32_t value, uint8_t frac);
+void SEG7_WriteGlyph(uint8_t row, uint8_t width, SEG7_Glyph glyph);
+
+#define SEG7_WriteInt(row, width, value) SEG7_WriteFixed((row), (width), (value), 0)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __SEG7_H
@@ -0,0 +1,153 @@
+#ifndef __SPSC_RING_HPP
+#define __SPSC_RING_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * @brief 单生产者单消费者无锁环形队列（中断 → 主循环的数据交接）
+ *
+ * - 容量 N 须为 2 的幂，N 个槽全部可用；head/tail 为自由增长的 32 位计数，差值即元素数
+ * - head 只由生产者写，tail 只由消费者写，两端各自只需一次 acquire 读和一次 release 写，
+ *   Cortex-M3 上为普通 LDR/STR 加 DMB，不需要关中断
+ * - 一个队列只能有一个生产者上下文和一个消费者上下文，例如 ADC 中断写、主循环读
+ * - 支持整段拷贝（push/pop 数组）和零拷贝（write_span/commit、read_span/consume）两种批量方式
+ */
+template <typename T, std::size_t N>
+class SpscRing {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "SpscRing 容量须为 2 的幂");
+    static_assert(N <= (1u << 31), "SpscRing 容量过大");
+    static_assert(std::is_trivially_copyable<T>::value, "SpscRing 元素须可平凡拷贝");
+
+public:
+    using size_type = uint32_t;
+
+    // 连续的一段缓冲区
+    template <typename U>
+    struct Span {
+        U *data;
+        size_type size;
+    };
+
+    constexpr SpscRing() noexcept = default;
+    SpscRing(const SpscRing &) = delete;
+    SpscRing &operator=(const SpscRing &) = delete;
+
+    static constexpr size_type capacity() noexcept { return static_cast<size_type>(N); }
+
+    // 生产者端 ---------------------------------------------------------------
+
+    bool push(const T &value) noexcept
+    {
+        const size_type head = head_.load(std::memory_order_relaxed);
+        if (head - tail_.load(std::memory_order_acquire) == N) {
+            return false;
+        }
+        buf_[head & kMask] = value;
+        head_.store(head + 1u, std::memory_order_release);
+        return true;
+    }
+
+    // 尽量多地写入 count 个元素，返回实际写入数
+    size_type push(const T *src, size_type count) noexcept
+    {
+        const size_type head = head_.load(std::memory_order_relaxed);
+        const size_type free = static_cast<size_type>(N) - (head - tail_.load(std::memory_order_acquire));
+        if (count > free) {
+            count = free;
+        }
+        const size_type first = contiguous(head, count);
+        copy(&buf_[head & kMask], src, first);
+        copy(&buf_[0], src + first, count - first);
+        head_.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    // 当前可直接写入的连续空闲区，写完后调用 commit
+    Span<T> write_span() noexcept
+    {
+        const size_type head = head_.load(std::memory_order_relaxed);
+        const size_type free = static_cast<size_type>(N) - (head - tail_.load(std::memory_order_acquire));
+        return {&buf_[head & kMask], contiguous(head, free)};
+    }
+
+    void commit(size_type count) noexcept
+    {
+        head_.store(head_.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+
+    // 消费者端 ---------------------------------------------------------------
+
+    bool pop(T &out) noexcept
+    {
+        const size_type tail = tail_.load(std::memory_order_relaxed);
+        if (head_.load(std::memory_order_acquire) == tail) {
+            return false;
+        }
+        out = buf_[tail & kMask];
+        tail_.store(tail + 1u, std::memory_order_release);
+        return true;
+    }
+
+    // 尽量多地取出 count 个元素，返回实际取出数
+    size_type pop(T *dst, size_type count) noexcept
+    {
+        const size_type tail = tail_.load(std::memory_order_relaxed);
+        const size_type used = head_.load(std::memory_order_acquire) - tail;
+        if (count > used) {
+            count = used;
+        }
+        const size_type first = contiguous(tail, count);
+        copy(dst, &buf_[tail & kMask], first);
+        copy(dst + first, &buf_[0], count - first);
+        tail_.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    // 当前可直接读取的连续数据区，读完后调用 consume
+    Span<const T> read_span() const noexcept
+    {
+        const size_type tail = tail_.load(std::memory_order_relaxed);
+        const size_type used = head_.load(std::memory_order_acquire) - tail;
+        return {&buf_[tail & kMask], contiguous(tail, used)};
+    }
+
+    void consume(size_type count) noexcept
+    {
+        tail_.store(tail_.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+
+    // 两端均可调用，结果只是某一时刻的近似值 --------------------------------
+
+    size_type size() const noexcept
+    {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+    }
+
+    bool empty() const noexcept { return size() == 0; }
+
+private:
+    static constexpr size_type kMask = static_cast<size_type>(N - 1);
+
+    // 从计数 index 开始、不超过 count 个元素时，到缓冲区末尾前的连续元素数
+    static constexpr size_type contiguous(size_type index, size_type count) noexcept
+    {
+        const size_type to_end = static_cast<size_type>(N) - (index & kMask);
+        return count < to_end ? count : to_end;
+    }
+
+    static void copy(T *dst, const T *src, size_type count) noexcept
+    {
+        for (size_type i = 0; i < count; i++) {
+            dst[i] = src[i];
+        }
+    }
+
+    T buf_[N]{};
+    std::atomic<size_type> head_{0};
+    std::atomic<size_type> tail_{0};
+};
+
+#endif // __SPSC_RING_HPP
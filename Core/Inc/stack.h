@@ -0,0 +1,43 @@
+#ifndef __STACK_H
+#define __STACK_H
+
+#include "main.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 主栈高水位：启动代码（startup_stm32f103c8tx.s）在清零 .bss 之后把 _ebss 到栈顶之间的
+ * 空闲 RAM 全部填为 STACK_PAINT，运行时从堆曾到达的最高地址（_end + brk_peak，见 heap.h；
+ * 其下的涂色已被堆改写）向上找第一个被改写的字，即为栈曾经到达的最深位置。
+ * 扫描覆盖整个空闲区而不只是链接脚本预留的 _Min_Stack_Size，超出预留的用量也如实报告。
+ * 本工程没有 RTOS，线程与全部中断共用 MSP，一次扫描即覆盖最坏的中断嵌套。
+ */
+#define STACK_PAINT 0xA5A5A5A5u     // 须与启动代码中的填充值一致
+
+typedef struct {
+    uint32_t size;          // 预留的栈大小（_Min_Stack_Size），字节
+    uint32_t used;          // 历史最大使用量，字节，可大于 size
+    uint32_t overflow;      // 1：used 超过预留，已进入 _sbrk 可分配的区域
+} STACK_Stats;
+
+// 遥测 TLM_CH_STACK 的数据（小端）
+typedef STACK_Stats STACK_Report;
+
+/**
+ * @brief 扫描栈高水位，只能在线程上下文调用
+ *        每次扫描堆顶峰值到上次水位之间（通常为空闲 RAM 的大部分，约几 KB），只适合低频调用
+ */
+void STACK_GetStats(STACK_Stats *out);
+
+/**
+ * @brief 经遥测发送当前统计，只能在线程上下文调用
+ */
+void STACK_Dump(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __STACK_H
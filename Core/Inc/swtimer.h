@@ -0,0 +1,94 @@
+#ifndef __SWTIMER_H
+#define __SWTIMER_H
+
+#include "main.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 分层时间轮：第0层 256 槽 × 1ms，第1层 64 槽 × 256ms，第2层 64 槽 × 16.384s
+#define SWT_L0_BITS 8
+#define SWT_LN_BITS 6
+// 最长定时约 17.9 分钟，更长的定时会在最远的槽中多次级联，仍然准时
+#define SWT_MAX_SPAN (1ul << (SWT_L0_BITS + 2 * SWT_LN_BITS))
+
+typedef struct SWT_Node {
+    struct SWT_Node *next;
+    struct SWT_Node *prev;
+} SWT_Node;
+
+typedef struct SWT_Timer SWT_Timer;
+typedef void (*SWT_Callback)(SWT_Timer *timer, void *arg);
+
+struct SWT_Timer {
+    SWT_Node node;          // 须为第一个成员
+    uint32_t expires;       // 到期时刻（SWT 时基 tick）
+    uint32_t period;        // 0 为单次定时
+    SWT_Callback callback;
+    void *arg;
+    volatile uint8_t state; // 由时间轮维护
+};
+
+/**
+ * @brief 初始化时间轮，须在 SysTick 调用 SWT_Tick 之前执行
+ */
+void SWT_Init(void);
+
+/**
+ * @brief 启动（或重新启动）定时器，O(1)
+ *        可在线程上下文及抢占优先级不高于 SysTick 的中断中调用（见 irq.h）
+ * @param delay_ms  首次到期的延时，0 按 1 处理
+ * @param period_ms 0 为单次；否则到期后按此周期保持相位重复
+ * @param callback  在线程上下文（SWT_Process）中调用
+ */
+void SWT_Start(SWT_Timer *timer, uint32_t delay_ms, uint32_t period_ms,
+               SWT_Callback callback, void *arg);
+
+/**
+ * @brief 停止定时器，包括已到期但回调尚未执行的，O(1)；调用上下文同 SWT_Start
+ */
+void SWT_Stop(SWT_Timer *timer);
+
+uint8_t SWT_IsActive(const SWT_Timer *timer);
+
+// 时间轮当前时刻
+uint32_t SWT_Now(void);
+
+/**
+ * @brief 推进 1ms，在 SysTick 中断中调用
+ *        到期的定时器整槽移入到期链表，到期链表由空变非空时调用 SWT_ExpiredCallback
+ */
+void SWT_Tick(void);
+
+/**
+ * @brief 补计 ticks 个未经 SWT_Tick 的 tick（无滴答休眠唤醒后调用，中断上下文或屏蔽 SysTick 时）
+ */
+void SWT_Advance(uint32_t ticks);
+
+/**
+ * @brief 距下一次有定时器到期或需要级联的 tick 数，供无滴答休眠决定休眠时长
+ * @retval 0 已有到期未处理的定时器；最多扫描一圈第0层，超出时返回 256（保守值）
+ */
+uint32_t SWT_NextExpiry(void);
+
+/**
+ * @brief 每次 SWT_Start 加一，休眠期间中断启动了新定时器时据此提前结束休眠
+ */
+uint32_t SWT_Revision(void);
+
+/**
+ * @brief 执行所有已到期定时器的回调，在线程上下文中调用
+ */
+void SWT_Process(void);
+
+/**
+ * @brief 有定时器到期（中断上下文），弱定义为空，应用在此唤醒调用 SWT_Process 的任务
+ */
+void SWT_ExpiredCallback(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __SWTIMER_H
@@ -0,0 +1,68 @@
+#ifndef __TELEMETRY_H
+#define __TELEMETRY_H
+
+#include "main.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 遥测链路：USART1 TX（PA9）+ DMA1 通道4，只发不收。
+ * 工程未引入 HAL UART 驱动，外设由本模块直接按寄存器配置，不在 DEV.ioc 中，PA9 须保留给本模块。
+ *
+ * 帧格式：COBS(通道号 + 数据 + CRC16-CCITT 小端) + 0x00
+ *   CRC 初值 0xFFFF、多项式 0x1021，覆盖通道号与数据；多字节字段均为小端
+ */
+#ifndef TLM_BAUD
+#define TLM_BAUD 921600u
+#endif
+
+// 发送环形缓冲大小（字节），须为 2 的幂
+#define TLM_TX_SIZE 2048u
+
+// 单帧数据最大长度（不含通道号与 CRC）
+#define TLM_MAX_PAYLOAD 240u
+
+// 通道号，主机按此解析数据
+typedef enum {
+    TLM_CH_TEXT = 0,        // UTF-8 文本
+    TLM_CH_ISRPROF,         // PROF_Report，见 isrprof.h
+    TLM_CH_IRQLAT,          // LAT_Report，见 irqlat.h
+    TLM_CH_IRQLAT_TRACE,    // LAT_TraceReport
+    TLM_CH_CPULOAD,         // LOAD_Report，见 cpuload.h
+    TLM_CH_STACK,           // STACK_Report，见 stack.h
+    TLM_CH_HEAP,            // HEAP_Report，见 heap.h
+    TLM_CH_LOG,             // 二进制日志记录，见 log.h，由 Tools/logdec 解码
+    TLM_CH_METRICS,         // 指标块快照，见 metrics.h，由 Tools/metricdump 解码
+    TLM_CH_TRACE,           // 事件跟踪转储，见 trace.h，由 Tools/tracejson 转换
+} TLM_Channel;
+
+/*
+ * 统计在指标块中（metrics.h），均只由 TLM_Send 写：
+ *   tlm_frames   已入队的帧
+ *   tlm_dropped  缓冲区不足而丢弃的帧
+ *   tlm_bytes    已入队的编码后字节数
+ */
+
+/**
+ * @brief 配置 USART1、PA9 与 DMA1 通道4（中断优先级由 IRQ_Init 设置）
+ */
+HAL_StatusTypeDef TLM_Init(void);
+
+/**
+ * @brief 编码一帧放入发送缓冲并在 DMA 空闲时启动发送，只能在线程上下文调用
+ * @retval HAL_OK；HAL_BUSY 缓冲区不足，本帧丢弃；HAL_ERROR 数据过长或未初始化
+ */
+HAL_StatusTypeDef TLM_Send(TLM_Channel channel, const void *data, uint16_t len);
+
+/**
+ * @brief DMA1 通道4 中断处理，在 DMA1_Channel4_IRQHandler 中调用
+ */
+void TLM_IRQHandler(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __TELEMETRY_H
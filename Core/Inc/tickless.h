@@ -0,0 +1,40 @@
+#ifndef __TICKLESS_H
+#define __TICKLESS_H
+
+#include "main.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 可休眠时间短于该值（ms）时只做普通 WFI
+#define TICKLESS_MIN_MS 2u
+
+/*
+ * 统计在指标块中（metrics.h）：
+ *   tickless_sleeps         拉长 SysTick 的休眠次数
+ *   tickless_early          其中因任务提交、按键或新定时器提前结束的次数
+ *   tickless_wakeups        休眠期间被 TIM2/EXTI 等中断唤醒、处理后继续休眠的次数
+ *   tickless_ticks_skipped  省去的 SysTick 中断数
+ */
+
+/**
+ * @brief 无滴答空闲：在 SCHED_Idle 中调用（PRIMASK 已置位）
+ *
+ * 取调度器、软件定时器的下次到期中较早者，按键消抖进行中时不休眠；
+ * 可休眠不少于 TICKLESS_MIN_MS 时把 SysTick 重装载值拉长到该时刻（最长约 233ms），
+ * 醒来后按 SysTick 实际走过的计数补计 uwTick 与时间轮，并恢复 1ms 时基。
+ *
+ * 休眠期间抢占优先级高于 SysTick 的中断（TIM2、EXTI、USART）照常执行，执行完若没有新工作
+ * 就继续休眠，不回到调度循环；这些中断中的 HAL_GetTick 按 SysTick 计数推算，保持准确且单调。
+ * 屏幕刷新运行时 CPU 仍会被 TIM2 频繁唤醒，省下的只是 1kHz 的 SysTick 及其后的调度循环。
+ *
+ * @param idle_ms 调度器给出的可空闲时间（ms）
+ */
+void TICKLESS_Idle(uint32_t idle_ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __TICKLESS_H
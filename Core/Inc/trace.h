@@ -0,0 +1,132 @@
+#ifndef __TRACE_H
+#define __TRACE_H
+
+#include "main.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 事件跟踪：任务开始/结束、中断进入/退出、队列溢出等事件写入 RAM 中的环（飞行记录器），
+ * 写满后覆盖最旧的事件；故障时 TRACE_Freeze 冻结，保留故障前最后 TRACE_DEPTH 个事件。
+ *
+ * 每个事件 8 字节：32 位 DWT 周期时间戳 + 类型/编号/参数。写入为一次 LDREX/STREX 取得槽位
+ * 加两次 STR，约 15 个周期，任意中断和线程都可调用。时间戳在取得槽位之后读取，被抢占时
+ * 相邻事件的顺序可能与时间戳不一致，主机按时间戳排序。
+ *
+ * 中断的进入/退出由 PROF_ENTER/PROF_EXIT（isrprof.h）一并产生，编号为 PROF_Id；
+ * 任务编号为注册顺序（SCHED_Task.id）。TRACE_Dump 把冻结的环经遥测分帧发出，
+ * 由 Tools/tracejson 转为 Chrome trace JSON（chrome://tracing 或 Perfetto 打开）。
+ * 环位于 .noinit 段，故障复位后由 CRASH_Init 调用 TRACE_Restore 恢复为冻结状态（crash.h）。
+ */
+#ifndef TRACE_ENABLE
+#if defined(DEBUG) && !defined(NDEBUG)
+#define TRACE_ENABLE 1
+#else
+#define TRACE_ENABLE 0
+#endif
+#endif
+
+#define TRACE_DEPTH 256u        // 2 的幂
+
+typedef enum {
+    TRACE_TASK_START = 1,       // id = 任务编号
+    TRACE_TASK_END,
+    TRACE_ISR_ENTER,            // id = PROF_Id
+    TRACE_ISR_EXIT,
+    TRACE_OVERFLOW,             // id = TRACE_Queue，arg = 累计丢弃数（低 16 位）
+    TRACE_MARK,                 // 应用自定义标记
+} TRACE_Type;
+
+typedef enum {
+    TRACE_Q_KEY = 0,
+    TRACE_Q_EXTI,
+    TRACE_Q_LOG,
+    TRACE_Q_TLM,
+} TRACE_Queue;
+
+typedef struct {
+    uint32_t cycles;            // DWT->CYCCNT
+    uint32_t info;              // 位 0–7 TRACE_Type，8–15 编号，16–31 参数
+} TRACE_Entry;
+
+/*
+ * 遥测 TLM_CH_TRACE 的数据（小端）。一次转储先发一个头帧，再按从旧到新的顺序发若干事件帧：
+ *   头帧：TRACE_DumpHeader，随后 tasks 个 8 字节任务名（不足补 0）
+ *   事件帧：TRACE_DumpChunk，随后若干 TRACE_Entry
+ */
+#define TRACE_KIND_HEADER 0u
+#define TRACE_KIND_EVENTS 1u
+#define TRACE_NAME_LEN    8u
+
+typedef struct __attribute__((packed)) {
+    uint8_t kind;               // TRACE_KIND_HEADER
+    uint8_t tasks;
+    uint16_t count;             // 有效事件数
+    uint32_t sequence;          // 转储序号
+    uint32_t cpu_hz;
+} TRACE_DumpHeader;
+
+typedef struct __attribute__((packed)) {
+    uint8_t kind;               // TRACE_KIND_EVENTS
+    uint8_t reserved;
+    uint16_t index;             // 本帧第一个事件在本次转储中的序号
+    uint32_t sequence;
+} TRACE_DumpChunk;
+
+#if TRACE_ENABLE
+
+extern TRACE_Entry trace_ring[TRACE_DEPTH];
+extern volatile uint32_t trace_head;       // 已写入的事件总数
+extern volatile uint8_t trace_frozen;
+
+static inline void TRACE_Event(TRACE_Type type, uint8_t id, uint16_t arg)
+{
+    if (trace_frozen) {
+        return;
+    }
+    uint32_t i = __atomic_fetch_add(&trace_head, 1u, __ATOMIC_RELAXED) & (TRACE_DEPTH - 1u);
+    trace_ring[i].cycles = DWT->CYCCNT;
+    trace_ring[i].info = (uint32_t)type | ((uint32_t)id << 8) | ((uint32_t)arg << 16);
+}
+
+#define TRACE_ISR_ENTER(id) TRACE_Event(TRACE_ISR_ENTER, (uint8_t)(id), 0)
+#define TRACE_ISR_EXIT(id)  TRACE_Event(TRACE_ISR_EXIT, (uint8_t)(id), 0)
+
+#else
+
+#define TRACE_Event(type, id, arg) ((void)0)
+#define TRACE_ISR_ENTER(id) ((void)0)
+#define TRACE_ISR_EXIT(id)  ((void)0)
+
+#endif
+
+/**
+ * @brief 停止记录，保留当前内容；可在故障处理中调用
+ */
+void TRACE_Freeze(void);
+
+/**
+ * @brief 清空并恢复记录
+ */
+void TRACE_Resume(void);
+
+/**
+ * @brief 复位后恢复故障前的环并保持冻结，head 为故障时的 trace_head；只能在中断开始之前调用
+ */
+void TRACE_Restore(uint32_t head);
+
+/**
+ * @brief 冻结并经遥测发送整个环，只能在线程上下文调用
+ *        发送环满时记下进度返回 HAL_BUSY，再次调用从断点继续；全部发完返回 HAL_OK 并保持冻结，
+ *        需要继续记录时调用 TRACE_Resume
+ * @retval HAL_OK 发送完成；HAL_BUSY 尚未发完；HAL_ERROR 未开启 TRACE_ENABLE
+ */
+HAL_StatusTypeDef TRACE_Dump(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __TRACE_H
@@ -90,7 +90,8 @@ void HAL_ADC_MspInit(ADC_HandleTypeDef* adcHandle)
     HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
 
   /* USER CODE BEGIN ADC2_MspInit 1 */
-
+    // 转换完成中断（HAL_ADC_Start_IT），优先级由 IRQ_Init 按 irq.h 设置
+    HAL_NVIC_EnableIRQ(ADC1_2_IRQn);
   /* USER CODE END ADC2_MspInit 1 */
   }
 }
@@ -112,7 +113,7 @@ void HAL_ADC_MspDeInit(ADC_HandleTypeDef* adcHandle)
     HAL_GPIO_DeInit(GPIOA, GPIO_PIN_4);
 
   /* USER CODE BEGIN ADC2_MspDeInit 1 */
-
+    HAL_NVIC_DisableIRQ(ADC1_2_IRQn);
   /* USER CODE END ADC2_MspDeInit 1 */
   }
 }
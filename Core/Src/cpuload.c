@@ -0,0 +1,99 @@
+#include "cpuload.h"
+#include "metrics.h"
+#include "swtimer.h"
+#include "telemetry.h"
+
+uint32_t load_sleep_cycles = 0;     // 只在线程上下文的空闲路径与取样中读写
+
+static SWT_Timer load_timer;
+static uint32_t last_cycles;
+static uint32_t last_sleep;
+static uint16_t history[LOAD_HISTORY];  // 1 秒样本，千分比
+static uint8_t history_pos = 0;
+
+// LOAD_Stats 各项在指标块中，只由取样回调（线程上下文）写
+METRIC_GAUGE(load_1s_permille);
+METRIC_GAUGE(load_10s_permille);
+METRIC_GAUGE(load_60s_permille);
+METRIC_GAUGE(load_peak_permille);
+METRIC_COUNTER(load_samples);
+
+// 最近 n 个样本的平均
+static uint16_t LOAD_Average(uint32_t n)
+{
+    uint32_t sum = 0;
+
+    if (n > metric_load_samples) {
+        n = metric_load_samples;
+    }
+    if (n == 0) {
+        return 0;
+    }
+    for (uint32_t i = 0; i < n; i++) {
+        sum += history[(history_pos + LOAD_HISTORY - 1u - i) % LOAD_HISTORY];
+    }
+    return (uint16_t)((sum + n / 2u) / n);
+}
+
+// 每秒一次，在软件定时器回调（线程上下文）中执行；按实际经过的周期计算，回调推迟也不影响结果
+static void LOAD_Sample(SWT_Timer *timer, void *arg)
+{
+    (void)timer;
+    (void)arg;
+
+    uint32_t now = DWT->CYCCNT;
+    uint32_t sleep = load_sleep_cycles;
+    uint32_t total = now - last_cycles;
+    uint32_t idle = sleep - last_sleep;
+    last_cycles = now;
+    last_sleep = sleep;
+
+    uint16_t load = 0;
+    if (total != 0 && idle < total) {
+        load = (uint16_t)(((uint64_t)(total - idle) * 1000u + total / 2u) / total);
+    }
+
+    history[history_pos] = load;
+    history_pos = (uint8_t)((history_pos + 1u) % LOAD_HISTORY);
+    METRIC_INC(load_samples);
+    METRIC_SET(load_1s_permille, load);
+    METRIC_SET(load_10s_permille, LOAD_Average(10u));
+    METRIC_SET(load_60s_permille, LOAD_Average(60u));
+    if (load > metric_load_peak_permille) {
+        METRIC_SET(load_peak_permille, load);
+    }
+}
+
+void LOAD_Init(void)
+{
+    last_cycles = DWT->CYCCNT;
+    last_sleep = load_sleep_cycles;
+    history_pos = 0;
+    METRIC_SET(load_1s_permille, 0);
+    METRIC_SET(load_10s_permille, 0);
+    METRIC_SET(load_60s_permille, 0);
+    METRIC_SET(load_peak_permille, 0);
+    metric_load_samples = 0;
+    SWT_Start(&load_timer, 1000, 1000, LOAD_Sample, NULL);
+}
+
+void LOAD_GetStats(LOAD_Stats *out)
+{
+    out->load_1s = (uint16_t)metric_load_1s_permille;
+    out->load_10s = (uint16_t)metric_load_10s_permille;
+    out->load_60s = (uint16_t)metric_load_60s_permille;
+    out->peak = (uint16_t)metric_load_peak_permille;
+    out->samples = metric_load_samples;
+}
+
+void LOAD_ResetPeak(void)
+{
+    METRIC_SET(load_peak_permille, metric_load_1s_permille);
+}
+
+void LOAD_Dump(void)
+{
+    LOAD_Report report;
+    LOAD_GetStats(&report);
+    TLM_Send(TLM_CH_CPULOAD, &report, sizeof(report));
+}
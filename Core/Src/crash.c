@@ -0,0 +1,103 @@
+#include "crash.h"
+#include "trace.h"
+#include "log.h"
+
+#define CRASH_WORDS (sizeof(CRASH_Record) / 4u)
+
+extern uint32_t _estack;            // 链接脚本定义
+
+static CRASH_Record record __attribute__((section(".noinit")));
+static CRASH_Record last;           // 本次启动前的记录，.bss
+static uint8_t have_last = 0;
+
+static uint32_t CRASH_Sum(const CRASH_Record *rec)
+{
+    const uint32_t *w = (const uint32_t *)rec;
+    uint32_t sum = 0;
+    for (uint32_t i = 1; i < CRASH_WORDS - 1u; i++) {
+        sum += w[i];
+    }
+    return ~sum;
+}
+
+static uint8_t CRASH_Valid(const CRASH_Record *rec)
+{
+    return (rec->magic == CRASH_MAGIC || rec->magic == CRASH_MAGIC_SEEN) && rec->check == CRASH_Sum(rec);
+}
+
+void CRASH_Fault(const uint32_t *frame, uint32_t exc_return)
+{
+    __disable_irq();
+    TRACE_Freeze();
+
+    uint32_t count = CRASH_Valid(&record) ? record.count + 1u : 1u;
+    if (exc_return & 4u) {
+        frame = (const uint32_t *)__get_PSP();
+    }
+    // 栈指针本身损坏时不去读入栈帧，以免在此再次出错锁死
+    const uint32_t *ram_end = &_estack;
+    uint8_t frame_ok = ((uint32_t)frame & 3u) == 0 && (uint32_t)frame >= SRAM_BASE && frame + 8 <= ram_end;
+
+    record.count = count;
+    record.exception = __get_IPSR();
+    record.r0 = frame_ok ? frame[0] : 0;
+    record.r1 = frame_ok ? frame[1] : 0;
+    record.r2 = frame_ok ? frame[2] : 0;
+    record.r3 = frame_ok ? frame[3] : 0;
+    record.r12 = frame_ok ? frame[4] : 0;
+    record.lr = frame_ok ? frame[5] : 0;
+    record.pc = frame_ok ? frame[6] : 0;
+    record.xpsr = frame_ok ? frame[7] : 0;
+    record.exc_return = exc_return;
+    record.cfsr = SCB->CFSR;
+    record.hfsr = SCB->HFSR;
+    record.bfar = SCB->BFAR;
+    record.mmfar = SCB->MMFAR;
+#if TRACE_ENABLE
+    record.trace_head = trace_head;
+#else
+    record.trace_head = 0;
+#endif
+    record.check = CRASH_Sum(&record);
+    record.magic = CRASH_MAGIC;
+
+    // 接着调试器时先停下，便于直接查看现场
+    if (CoreDebug->DHCSR & CoreDebug_DHCSR_C_DEBUGEN_Msk) {
+        __BKPT(0);
+    }
+    NVIC_SystemReset();
+}
+
+void CRASH_Init(void)
+{
+    if (CRASH_Valid(&record)) {
+        if (record.magic == CRASH_MAGIC) {
+            last = record;
+            have_last = 1;
+            record.magic = CRASH_MAGIC_SEEN;    // 再次复位不重复报告，次数继续累计
+            TRACE_Restore(last.trace_head);
+        }
+    } else {
+        record.count = 0;       // 上电，RAM 内容随机
+        record.check = CRASH_Sum(&record);
+        record.magic = CRASH_MAGIC_SEEN;
+    }
+    SCB->SHCSR |= SCB_SHCSR_MEMFAULTENA_Msk | SCB_SHCSR_BUSFAULTENA_Msk | SCB_SHCSR_USGFAULTENA_Msk;
+}
+
+const CRASH_Record *CRASH_GetLast(void)
+{
+    return have_last ? &last : NULL;
+}
+
+uint8_t CRASH_Report(void)
+{
+    if (!have_last) {
+        return 0;
+    }
+    LOG_ERROR("crash #%u: exception %u, pc %#010x lr %#010x", last.count, last.exception, last.pc, last.lr);
+    LOG_ERROR("crash: cfsr %#010x hfsr %#010x bfar %#010x mmfar %#010x", last.cfsr, last.hfsr, last.bfar, last.mmfar);
+    LOG_ERROR("crash: r0 %#010x r1 %#010x r2 %#010x r3 %#010x", last.r0, last.r1, last.r2, last.r3);
+    LOG_ERROR("crash: r12 %#010x xpsr %#010x exc_return %#010x", last.r12, last.xpsr, last.exc_return);
+    return (TRACE_ENABLE && last.trace_head != 0) ? 1u : 0u;
+}
@@ -0,0 +1,64 @@
+#include "defer.h"
+#include "metrics.h"
+
+// 提交者压入的后进先出链表，PendSV 整条取走后反转为先进先出
+static DEFER_Work *volatile pending_list = NULL;
+
+METRIC_COUNTER(defer_posted);       // 任意上下文提交，原子加
+METRIC_COUNTER(defer_coalesced);
+METRIC_COUNTER(defer_runs);         // 只由 PendSV 写
+METRIC_GAUGE(defer_batch_max);
+
+void DEFER_Init(void)
+{
+    pending_list = NULL;
+}
+
+uint8_t DEFER_Post(DEFER_Work *work)
+{
+    if (__atomic_exchange_n(&work->pending, 1u, __ATOMIC_ACQUIRE)) {
+        METRIC_INC_ATOMIC(defer_coalesced);
+        return 0;
+    }
+
+    DEFER_Work *head = __atomic_load_n(&pending_list, __ATOMIC_RELAXED);
+    do {
+        work->next = head;
+    } while (!__atomic_compare_exchange_n(&pending_list, &head, work, 1,
+                                          __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+    METRIC_INC_ATOMIC(defer_posted);
+
+    SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;
+    return 1;
+}
+
+void DEFER_Handler(void)
+{
+    uint32_t batch = 0;
+    DEFER_Work *list;
+
+    // 只有 PendSV 取走链表，整条交换不存在 ABA 问题
+    while ((list = __atomic_exchange_n(&pending_list, NULL, __ATOMIC_ACQUIRE)) != NULL) {
+        DEFER_Work *fifo = NULL;
+        while (list != NULL) {
+            DEFER_Work *next = list->next;
+            list->next = fifo;
+            fifo = list;
+            list = next;
+        }
+
+        while (fifo != NULL) {
+            DEFER_Work *work = fifo;
+            fifo = work->next;
+            // 先清除标志再执行：执行期间的新提交会再次入队，不会丢失
+            __atomic_store_n(&work->pending, 0u, __ATOMIC_RELEASE);
+            work->run(work->arg);
+            batch++;
+        }
+    }
+
+    METRIC_INC(defer_runs);
+    if ((int32_t)batch > metric_defer_batch_max) {
+        METRIC_SET(defer_batch_max, batch);
+    }
+}
@@ -0,0 +1,119 @@
+#include "display.h"
+#include "led.h"
+#include "metrics.h"
+
+#define CELL_INVALID 0xFFu   // 缓存初值，保证首次设置时全部编码
+
+typedef struct {
+    uint8_t row;
+    uint8_t width;
+} DISP_FieldLayout;
+
+// 字段上次渲染的内容
+typedef struct {
+    uint8_t is_glyph;
+    uint8_t frac;
+    int32_t value;          // 定点数值或 SEG7_Glyph
+} DISP_FieldState;
+
+static const DISP_FieldLayout field_layout[DISP_FIELD_COUNT] = {
+    [DISP_FIELD_TEMP] = {0, 3},
+    [DISP_FIELD_FLOW] = {3, 3},
+};
+
+static DISP_FieldState field_state[DISP_FIELD_COUNT];
+static uint8_t field_valid;             // 每个字段一位，置位表示 field_state 有效
+static uint8_t cell_cache[LED_MAX_ROWS]; // 每位当前显示的单元
+static uint8_t frame_dirty;
+
+METRIC_COUNTER(disp_published);
+METRIC_COUNTER(disp_skipped);
+METRIC_COUNTER(disp_busy);
+METRIC_COUNTER(disp_cells_encoded);
+
+void DISP_Init(void)
+{
+    for (uint8_t i = 0; i < LED_MAX_ROWS; i++) {
+        cell_cache[i] = CELL_INVALID;
+    }
+    field_valid = 0;
+    frame_dirty = 0;
+}
+
+// 只把与缓存不同的单元编码进 vram
+static void DISP_Render(const DISP_FieldLayout *layout, const uint8_t *cells)
+{
+    for (uint8_t i = 0; i < layout->width; i++) {
+        uint8_t pos = layout->row + i;
+        if (cells[i] != cell_cache[pos]) {
+            uint8_t bits = SEG7_Encode(cells[i]);
+            cell_cache[pos] = cells[i];
+            METRIC_INC(disp_cells_encoded);
+            if (bits != vram[pos]) {
+                vram[pos] = bits;
+                frame_dirty = 1;
+            }
+        }
+    }
+}
+
+// 与上次渲染内容相同时返回 1，否则记录新内容并返回 0
+static uint8_t DISP_Unchanged(DISP_Field field, uint8_t is_glyph, int32_t value, uint8_t frac)
+{
+    DISP_FieldState *state = &field_state[field];
+
+    if ((field_valid & (1u << field)) && state->is_glyph == is_glyph
+        && state->value == value && state->frac == frac) {
+        return 1;
+    }
+    state->is_glyph = is_glyph;
+    state->value = value;
+    state->frac = frac;
+    field_valid |= (uint8_t)(1u << field);
+    return 0;
+}
+
+void DISP_SetFixed(DISP_Field field, int32_t value, uint8_t frac)
+{
+    uint8_t cells[LED_MAX_ROWS];
+
+    if (field >= DISP_FIELD_COUNT || DISP_Unchanged(field, 0, value, frac)) {
+        return;
+    }
+    SEG7_FormatFixed(cells, field_layout[field].width, value, frac);
+    DISP_Render(&field_layout[field], cells);
+}
+
+void DISP_SetGlyph(DISP_Field field, SEG7_Glyph glyph)
+{
+    uint8_t cells[LED_MAX_ROWS];
+
+    if (field >= DISP_FIELD_COUNT || DISP_Unchanged(field, 1, (int32_t)glyph, 0)) {
+        return;
+    }
+    SEG7_FormatGlyph(cells, field_layout[field].width, glyph);
+    DISP_Render(&field_layout[field], cells);
+}
+
+void DISP_SetBrightness(uint8_t level)
+{
+    if (level != LED_GetBrightness()) {
+        LED_SetBrightness(level);
+        frame_dirty = 1;
+    }
+}
+
+HAL_StatusTypeDef DISP_Flush(void)
+{
+    if (!frame_dirty) {
+        METRIC_INC(disp_skipped);
+        return HAL_OK;
+    }
+    if (LED_Present() != HAL_OK) {
+        METRIC_INC(disp_busy);
+        return HAL_BUSY;
+    }
+    frame_dirty = 0;
+    METRIC_INC(disp_published);
+    return HAL_OK;
+}
@@ -1,5 +0,0 @@
-#include "exti.h"
-#include "key.h"
-#include "led.h"
-
-
@@ -0,0 +1,39 @@
+#include "exti.h"
+#include "key.h"
+#include "led.h"
+#include "trace.h"
+#include "metrics.h"
+#include "spsc_ring.hpp"
+
+namespace {
+
+// 生产者为 EXTI 中断，消费者为主循环（Task_Input）
+SpscRing<EXTI_Event, EXTI_QUEUE_SIZE> queue;
+
+} // namespace
+
+METRIC_COUNTER(exti_dropped);     // 只由 EXTI 中断写
+
+// PA8（LED_Pin）上升沿与 PC13（KEY_Pin）双边沿，由 HAL_GPIO_EXTI_IRQHandler 调用
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
+{
+    GPIO_TypeDef *port = (GPIO_Pin == KEY_Pin) ? KEY_GPIO_Port : LED_GPIO_Port;
+
+    if (GPIO_Pin == KEY_Pin) {
+        KEY_OnEdge();   // 唤醒消抖状态机，按键事件由它产生
+    }
+
+    EXTI_Event event;
+    event.pin = GPIO_Pin;
+    event.level = (port->IDR & GPIO_Pin) ? 1u : 0u;
+    event.tick = HAL_GetTick();
+    if (!queue.push(event)) {
+        METRIC_INC(exti_dropped);
+        TRACE_Event(TRACE_OVERFLOW, TRACE_Q_EXTI, (uint16_t)metric_exti_dropped);
+    }
+}
+
+uint8_t EXTI_GetEvent(EXTI_Event *event)
+{
+    return queue.pop(*event) ? 1u : 0u;
+}
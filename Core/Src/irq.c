@@ -0,0 +1,17 @@
+#include "irq.h"
+
+#if IRQ_LOCK_STATS
+uint32_t irq_lock_start;
+METRIC_GAUGE(irq_lock_max_cycles);
+#endif
+
+void IRQ_Init(void)
+{
+    HAL_NVIC_SetPriority(TIM2_IRQn, IRQ_PRIO_TIM2, IRQ_SUB_TIM2);
+    HAL_NVIC_SetPriority(DMA1_Channel4_IRQn, IRQ_PRIO_USART, IRQ_SUB_USART);
+    HAL_NVIC_SetPriority(EXTI9_5_IRQn, IRQ_PRIO_EXTI, IRQ_SUB_EXTI);
+    HAL_NVIC_SetPriority(EXTI15_10_IRQn, IRQ_PRIO_EXTI, IRQ_SUB_EXTI);
+    HAL_NVIC_SetPriority(ADC1_2_IRQn, IRQ_PRIO_ADC, IRQ_SUB_ADC);
+    HAL_NVIC_SetPriority(SysTick_IRQn, IRQ_PRIO_SYSTICK, IRQ_SUB_SYSTICK);
+    HAL_NVIC_SetPriority(PendSV_IRQn, IRQ_PRIO_PENDSV, IRQ_SUB_PENDSV);
+}
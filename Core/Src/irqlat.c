@@ -0,0 +1,232 @@
+#include "irqlat.h"
+#include "metrics.h"
+#include "mono.h"
+#include "scheduler.h"
+#include "telemetry.h"
+
+#if LAT_ENABLE
+
+// 更新事件的 LAT_Stats 各项在指标块中，只在 TIM2 中断（或关中断时）写
+METRIC_COUNTER(lat_count);
+METRIC_COUNTER(lat_ticks_total);
+METRIC_COUNTER(lat_resyncs);
+METRIC_GAUGE(lat_ticks_max);
+METRIC_GAUGE(lat_interval_min_cycles);
+METRIC_GAUGE(lat_interval_max_cycles);
+METRIC_GAUGE(lat_spread_cycles);
+
+static LAT_Trace trace[LAT_TRACE_DEPTH];
+static uint8_t trace_count = 0;
+
+// 更新事件的周期级相对延迟
+static uint8_t have_last = 0;
+static uint8_t have_interval = 0;   // interval_min/max 已有值
+static uint32_t last_entry;         // 上次入口的 DWT->CYCCNT
+static uint32_t last_expected;      // 上次入口时开始的时间片长度（周期）
+static int32_t rel;                 // 相对延迟累加值
+static int32_t rel_min;
+static int32_t rel_max;
+
+// 硬件压栈的 R0–R3、R12、LR、PC、xPSR 中取 PC；EXC_RETURN 位 2 为 1 时帧在 PSP 上
+static uint32_t LAT_StackedPc(const uint32_t *frame, uint32_t exc_return)
+{
+    if ((exc_return & 0xFFFFFFF0u) != 0xFFFFFFF0u) {
+        return 0;
+    }
+    if (exc_return & 4u) {
+        frame = (const uint32_t *)__get_PSP();
+    }
+    return frame[6];
+}
+
+static void LAT_TraceInsert(LAT_Source source, uint32_t late, uint16_t ticks, uint32_t pc)
+{
+    uint8_t pos = trace_count;
+
+    while (pos > 0 && trace[pos - 1u].late < late) {
+        pos--;
+    }
+    if (pos >= LAT_TRACE_DEPTH) {
+        return;
+    }
+    uint8_t last = (trace_count < LAT_TRACE_DEPTH) ? trace_count : (uint8_t)(LAT_TRACE_DEPTH - 1u);
+    for (uint8_t i = last; i > pos; i--) {
+        trace[i] = trace[i - 1u];
+    }
+    if (trace_count < LAT_TRACE_DEPTH) {
+        trace_count++;
+    }
+
+    const SCHED_Task *task = SCHED_Current();
+    LAT_Trace *t = &trace[pos];
+    t->when = MONO_Cycles();
+    t->late = late;
+    t->pc = pc;
+    t->active = NVIC->IABR[0] & ~(1uL << TIM2_IRQn);
+    t->task = task ? task->name : NULL;
+    t->ticks = ticks;
+    t->source = (uint8_t)source;
+}
+
+static void LAT_Update(TIM_TypeDef *tim, uint32_t now, uint16_t ticks, uint32_t pc)
+{
+    METRIC_INC(lat_count);
+    METRIC_ADD(lat_ticks_total, ticks);
+    if (ticks > metric_lat_ticks_max) {
+        METRIC_SET(lat_ticks_max, ticks);
+    }
+
+    if (have_last) {
+        int32_t diff = (int32_t)(now - last_entry - last_expected);
+        if (diff > (int32_t)(last_expected / 2u)) {
+            // 中间丢了一次更新，间隔不再对应一个时间片
+            METRIC_INC(lat_resyncs);
+            rel = 0;
+            rel_min = 0;
+            rel_max = 0;
+        } else {
+            if (!have_interval || diff < metric_lat_interval_min_cycles) {
+                METRIC_SET(lat_interval_min_cycles, diff);
+            }
+            if (!have_interval || diff > metric_lat_interval_max_cycles) {
+                METRIC_SET(lat_interval_max_cycles, diff);
+            }
+            have_interval = 1;
+            rel += diff;
+            if (rel < rel_min) {
+                rel_min = rel;
+            }
+            if (rel > rel_max) {
+                rel_max = rel;
+            }
+            METRIC_SET(lat_spread_cycles, rel_max - rel_min);
+            LAT_TraceInsert(LAT_SRC_UPDATE, (uint32_t)(rel - rel_min), ticks, pc);
+        }
+    }
+
+    // ARR 预装载：入口时 ARR 中是本次更新刚装入的时间片长度，刷新中断稍后才写入下一片
+    have_last = 1;
+    last_entry = now;
+    last_expected = (tim->ARR + 1u) * (tim->PSC + 1u);
+}
+
+void LAT_TimerEntry(TIM_TypeDef *tim, const uint32_t *frame, uint32_t exc_return)
+{
+    uint32_t now = DWT->CYCCNT;
+    uint16_t cnt = (uint16_t)tim->CNT;
+
+    if ((tim->SR & TIM_SR_UIF) && (tim->DIER & TIM_DIER_UIE)) {
+        LAT_Update(tim, now, cnt, LAT_StackedPc(frame, exc_return));
+    }
+}
+
+HAL_StatusTypeDef LAT_GetStats(LAT_Source source, LAT_Stats *out)
+{
+    if (source >= LAT_SRC_COUNT) {
+        return HAL_ERROR;
+    }
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    out->count = metric_lat_count;
+    out->ticks_max = (uint32_t)metric_lat_ticks_max;
+    out->ticks_total = metric_lat_ticks_total;
+    out->interval_min = metric_lat_interval_min_cycles;
+    out->interval_max = metric_lat_interval_max_cycles;
+    out->spread = (uint32_t)metric_lat_spread_cycles;
+    out->resyncs = metric_lat_resyncs;
+    __set_PRIMASK(primask);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef LAT_GetTrace(uint8_t rank, LAT_Trace *out)
+{
+    HAL_StatusTypeDef status = HAL_ERROR;
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (rank < trace_count) {
+        *out = trace[rank];
+        status = HAL_OK;
+    }
+    __set_PRIMASK(primask);
+    return status;
+}
+
+void LAT_Reset(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    metric_lat_count = 0;
+    metric_lat_ticks_total = 0;
+    metric_lat_resyncs = 0;
+    METRIC_SET(lat_ticks_max, 0);
+    METRIC_SET(lat_interval_min_cycles, 0);
+    METRIC_SET(lat_interval_max_cycles, 0);
+    METRIC_SET(lat_spread_cycles, 0);
+    trace_count = 0;
+    have_last = 0;
+    have_interval = 0;
+    rel = 0;
+    rel_min = 0;
+    rel_max = 0;
+    __set_PRIMASK(primask);
+}
+
+void LAT_Dump(void)
+{
+    LAT_Stats s;
+    LAT_Trace t;
+
+    for (uint32_t i = 0; i < LAT_SRC_COUNT; i++) {
+        LAT_Report report;
+        LAT_GetStats((LAT_Source)i, &s);
+        report.source = (uint8_t)i;
+        report.count = s.count;
+        report.ticks_max = s.ticks_max;
+        report.ticks_mean_q8 = s.count ? (uint32_t)(((uint64_t)s.ticks_total << 8) / s.count) : 0u;
+        report.interval_min = s.interval_min;
+        report.interval_max = s.interval_max;
+        report.spread = s.spread;
+        report.resyncs = s.resyncs;
+        TLM_Send(TLM_CH_IRQLAT, &report, sizeof(report));
+    }
+    for (uint8_t rank = 0; LAT_GetTrace(rank, &t) == HAL_OK; rank++) {
+        LAT_TraceReport report = {0};
+        report.rank = rank;
+        report.source = t.source;
+        report.ticks = t.ticks;
+        report.late = t.late;
+        report.pc = t.pc;
+        report.active = t.active;
+        report.when = t.when;
+        for (uint8_t i = 0; t.task != NULL && i < sizeof(report.task) && t.task[i] != '\0'; i++) {
+            report.task[i] = t.task[i];
+        }
+        TLM_Send(TLM_CH_IRQLAT_TRACE, &report, sizeof(report));
+    }
+}
+
+#else
+
+HAL_StatusTypeDef LAT_GetStats(LAT_Source source, LAT_Stats *out)
+{
+    (void)source;
+    (void)out;
+    return HAL_ERROR;
+}
+
+HAL_StatusTypeDef LAT_GetTrace(uint8_t rank, LAT_Trace *out)
+{
+    (void)rank;
+    (void)out;
+    return HAL_ERROR;
+}
+
+void LAT_Reset(void)
+{
+}
+
+void LAT_Dump(void)
+{
+}
+
+#endif
@@ -0,0 +1,164 @@
+#include "isrprof.h"
+#include "metrics.h"
+#include "telemetry.h"
+
+#if PROF_ENABLE
+
+volatile uint32_t prof_nested = 0;      // 已结束的中断独占时间之和，用于扣除抢占
+
+// 次数、最短与最长耗时在指标块中（isr_<名称>_count/_min/_max），累计耗时与直方图只在这里
+typedef struct {
+    uint64_t total;
+    uint16_t hist[PROF_HIST_BUCKETS];
+} PROF_Detail;
+
+static PROF_Detail prof[PROF_COUNT];
+
+#define PROF_METRICS(name) \
+    METRIC_COUNTER(isr_##name##_count); \
+    METRIC_GAUGE(isr_##name##_min); \
+    METRIC_GAUGE(isr_##name##_max)
+
+PROF_METRICS(systick);
+PROF_METRICS(tim2);
+PROF_METRICS(exti9_5);
+PROF_METRICS(exti15_10);
+PROF_METRICS(pendsv);
+PROF_METRICS(dma1_ch4);
+PROF_METRICS(adc);
+_Static_assert(PROF_COUNT == 7, "add the metrics and table entries below for a new PROF_Id");
+
+static volatile uint32_t *const prof_count[PROF_COUNT] = {
+    [PROF_SYSTICK] = &metric_isr_systick_count,
+    [PROF_TIM2] = &metric_isr_tim2_count,
+    [PROF_EXTI9_5] = &metric_isr_exti9_5_count,
+    [PROF_EXTI15_10] = &metric_isr_exti15_10_count,
+    [PROF_PENDSV] = &metric_isr_pendsv_count,
+    [PROF_DMA1_CH4] = &metric_isr_dma1_ch4_count,
+    [PROF_ADC] = &metric_isr_adc_count,
+};
+static volatile int32_t *const prof_min[PROF_COUNT] = {
+    [PROF_SYSTICK] = &metric_isr_systick_min,
+    [PROF_TIM2] = &metric_isr_tim2_min,
+    [PROF_EXTI9_5] = &metric_isr_exti9_5_min,
+    [PROF_EXTI15_10] = &metric_isr_exti15_10_min,
+    [PROF_PENDSV] = &metric_isr_pendsv_min,
+    [PROF_DMA1_CH4] = &metric_isr_dma1_ch4_min,
+    [PROF_ADC] = &metric_isr_adc_min,
+};
+static volatile int32_t *const prof_max[PROF_COUNT] = {
+    [PROF_SYSTICK] = &metric_isr_systick_max,
+    [PROF_TIM2] = &metric_isr_tim2_max,
+    [PROF_EXTI9_5] = &metric_isr_exti9_5_max,
+    [PROF_EXTI15_10] = &metric_isr_exti15_10_max,
+    [PROF_PENDSV] = &metric_isr_pendsv_max,
+    [PROF_DMA1_CH4] = &metric_isr_dma1_ch4_max,
+    [PROF_ADC] = &metric_isr_adc_max,
+};
+
+static uint32_t PROF_Bucket(uint32_t cycles)
+{
+    if (cycles < 2u) {
+        return cycles;
+    }
+    uint32_t exp = 31u - (uint32_t)__CLZ(cycles);
+    uint32_t bucket = 2u * exp + ((cycles >> (exp - 1u)) & 1u);
+    return bucket < PROF_HIST_BUCKETS ? bucket : PROF_HIST_BUCKETS - 1u;
+}
+
+void PROF_Record(PROF_Id id, uint32_t start, uint32_t nested_base)
+{
+    uint32_t end = DWT->CYCCNT;
+
+    // 更高优先级的中断可能在此期间结束并累加 prof_nested，读改写须原子
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint32_t nested = prof_nested;
+    uint32_t cycles = (end - start) - (nested - nested_base);
+    prof_nested = nested + cycles;
+
+    PROF_Detail *d = &prof[id];
+    if (*prof_count[id] == 0 || cycles < (uint32_t)*prof_min[id]) {
+        *prof_min[id] = (int32_t)cycles;
+    }
+    if (cycles > (uint32_t)*prof_max[id]) {
+        *prof_max[id] = (int32_t)cycles;
+    }
+    (*prof_count[id])++;
+    d->total += cycles;
+    uint16_t *slot = &d->hist[PROF_Bucket(cycles)];
+    if (*slot != UINT16_MAX) {
+        (*slot)++;
+    }
+    __set_PRIMASK(primask);
+}
+
+HAL_StatusTypeDef PROF_GetStats(PROF_Id id, PROF_Stats *out)
+{
+    if (id >= PROF_COUNT) {
+        return HAL_ERROR;
+    }
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    out->count = *prof_count[id];
+    out->min = (uint32_t)*prof_min[id];
+    out->max = (uint32_t)*prof_max[id];
+    out->total = prof[id].total;
+    for (uint32_t b = 0; b < PROF_HIST_BUCKETS; b++) {
+        out->hist[b] = prof[id].hist[b];
+    }
+    __set_PRIMASK(primask);
+    return HAL_OK;
+}
+
+void PROF_Reset(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    for (uint32_t i = 0; i < PROF_COUNT; i++) {
+        prof[i] = (PROF_Detail){0};
+        *prof_count[i] = 0;
+        *prof_min[i] = 0;
+        *prof_max[i] = 0;
+    }
+    __set_PRIMASK(primask);
+}
+
+void PROF_Dump(void)
+{
+    PROF_Stats s;
+    PROF_Report report;
+
+    for (uint32_t i = 0; i < PROF_COUNT; i++) {
+        PROF_GetStats((PROF_Id)i, &s);
+        report.id = (uint8_t)i;
+        report.buckets = PROF_HIST_BUCKETS;
+        report.count = s.count;
+        report.min = s.min;
+        report.max = s.max;
+        report.mean = s.count ? (uint32_t)(s.total / s.count) : 0u;
+        for (uint32_t b = 0; b < PROF_HIST_BUCKETS; b++) {
+            report.hist[b] = s.hist[b];
+        }
+        TLM_Send(TLM_CH_ISRPROF, &report, sizeof(report));
+    }
+}
+
+#else
+
+HAL_StatusTypeDef PROF_GetStats(PROF_Id id, PROF_Stats *out)
+{
+    (void)id;
+    (void)out;
+    return HAL_ERROR;
+}
+
+void PROF_Reset(void)
+{
+}
+
+void PROF_Dump(void)
+{
+}
+
+#endif
@@ -1,12 +1,111 @@
 #include "key.h"
+#include "metrics.h"
+#include "trace.h"
 
-// 检测按键状态（PC13）
-uint8_t KEY_GetState(void) {
-    if (HAL_GPIO_ReadPin(GPIOC, GPIO_PIN_13) == GPIO_PIN_RESET) { // 按键按下（假设低电平有效）
-        HAL_Delay(20); // 简单消抖
-        if (HAL_GPIO_ReadPin(GPIOC, GPIO_PIN_13) == GPIO_PIN_RESET) {
-            return 1; // 按键确实按下
+#if (KEY_QUEUE_SIZE & (KEY_QUEUE_SIZE - 1)) != 0
+#error "KEY_QUEUE_SIZE 须为 2 的幂"
+#endif
+
+METRIC_COUNTER(key_presses);    // 只在 SysTick 中更新
+
+static volatile uint8_t armed = 1;      // 0：稳定松开，KEY_Tick 直接返回
+static uint8_t integrator = 0;          // 0 = 稳定松开，KEY_DEBOUNCE_MS = 稳定按下
+static volatile uint8_t pressed = 0;    // 消抖后的状态
+static uint16_t held_ms = 0;            // 本次按下已持续的时间
+
+// 单生产者（SysTick）单消费者（主循环）队列，索引各由一方写入，无需关中断
+static volatile uint8_t queue[KEY_QUEUE_SIZE];
+static volatile uint8_t queue_head = 0;
+static volatile uint8_t queue_tail = 0;
+static uint16_t queue_dropped = 0;
+
+static void KEY_Post(KEY_Event event)
+{
+    uint8_t head = queue_head;
+    if ((uint8_t)(head - queue_tail) < KEY_QUEUE_SIZE) {   // 队列满时丢弃
+        queue[head & (KEY_QUEUE_SIZE - 1u)] = (uint8_t)event;
+        queue_head = (uint8_t)(head + 1u);
+    } else {
+        TRACE_Event(TRACE_OVERFLOW, TRACE_Q_KEY, ++queue_dropped);
+    }
+}
+
+// 稳定松开后停止采样。先清标志再读引脚：清除前后到来的边沿要么重新置位标志，
+// 要么已体现在读到的电平上，不会丢失按下
+static void KEY_Sleep(void)
+{
+    armed = 0;
+    if ((KEY_GPIO_Port->IDR & KEY_Pin) == 0) {
+        armed = 1;
+    }
+}
+
+void KEY_OnEdge(void)
+{
+    armed = 1;
+}
+
+uint8_t KEY_IsIdle(void)
+{
+    return !armed;
+}
+
+void KEY_Tick(void)
+{
+    if (!armed) {
+        return;
+    }
+
+    // 按键低电平有效
+    if ((KEY_GPIO_Port->IDR & KEY_Pin) == 0) {
+        if (integrator < KEY_DEBOUNCE_MS) {
+            integrator++;
+        }
+    } else if (integrator > 0) {
+        integrator--;
+    }
+
+    if (!pressed) {
+        if (integrator == KEY_DEBOUNCE_MS) {
+            pressed = 1;
+            held_ms = 0;
+            METRIC_INC(key_presses);
+            KEY_Post(KEY_EVENT_PRESS);
+        } else if (integrator == 0) {
+            KEY_Sleep();
         }
+        return;
+    }
+
+    if (integrator == 0) {
+        pressed = 0;
+        KEY_Post(KEY_EVENT_RELEASE);
+        KEY_Sleep();
+        return;
+    }
+
+    // 长按与连发只在按住期间计时
+    held_ms++;
+    if (held_ms == KEY_LONG_MS) {
+        KEY_Post(KEY_EVENT_LONG);
+    } else if (held_ms == KEY_LONG_MS + KEY_REPEAT_MS) {
+        held_ms = KEY_LONG_MS;
+        KEY_Post(KEY_EVENT_REPEAT);
+    }
+}
+
+KEY_Event KEY_GetEvent(void)
+{
+    uint8_t tail = queue_tail;
+    if (tail == queue_head) {
+        return KEY_EVENT_NONE;
     }
-    return 0; // 按键未按下
+    KEY_Event event = (KEY_Event)queue[tail & (KEY_QUEUE_SIZE - 1u)];
+    queue_tail = (uint8_t)(tail + 1u);
+    return event;
+}
+
+// 检测按键状态（PC13）
+uint8_t KEY_GetState(void) {
+    return pressed;
 }
@@ -1,36 +1,213 @@
 #include "main.h"
-#include <string.h>
+#include "led.h"
 
-#define ROWS 6  // 共6行（LED1–LED6）
-uint8_t vram[ROWS];               // 用户写入的显存
-static uint8_t vram_real[ROWS];  // 实际刷新的显存
-static uint8_t current_row = 0;
+static const uint16_t default_row_pins[] = {LED_DEFAULT_ROW_PINS};
+static const uint16_t default_col_pins[] = {LED_DEFAULT_COL_PINS};
 
-// 需要在main中定义外部定时器句柄
-extern TIM_HandleTypeDef htim14;
+const LED_Geometry LED_DefaultGeometry = {
+    .port = GPIOB,
+    .row_pins = default_row_pins,
+    .col_pins = default_col_pins,
+    .rows = sizeof(default_row_pins) / sizeof(default_row_pins[0]),
+    .cols = sizeof(default_col_pins) / sizeof(default_col_pins[0]),
+    .row_active_high = 1,
+    .col_active_high = 1,
+};
 
-void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
+uint8_t vram[LED_MAX_ROWS];               // 用户写入的显存
+
+// 初始化时由几何描述生成的掩码，之后编码与刷新都不再关心具体引脚
+static GPIO_TypeDef *led_port = GPIOB;
+static uint8_t led_rows = 0;
+static uint8_t led_cols = 0;
+static uint8_t slice_count = 0;
+static uint16_t row_mask[LED_MAX_ROWS];   // 第 r 行的引脚
+static uint16_t col_mask_lo[16];          // vram 低4位 → 列引脚
+static uint16_t col_mask_hi[16];          // vram 高4位 → 列引脚
+static uint16_t all_mask;                 // 全部行列引脚
+static uint16_t active_low_mask;          // 低电平有效的引脚
+static uint32_t plane_arr[LED_BCM_BITS];  // 位平面 b 的 ARR 值
+static TIM_HandleTypeDef *led_htim = NULL;
+
+// BCM 帧：每个时间片是一个完整的 BSRR 写入值（置位与复位部分互补，覆盖全部行列引脚），
+// 位平面 b 的时间片持续 LED_BCM_UNIT_TICKS << b 个计数。
+// 中断只需“写 BSRR + 写 ARR”，同一张表也可以由 TIM 更新事件触发的 DMA 直接搬运到 BSRR。
+static uint32_t frame_buf[2][LED_MAX_SLICES];
+static const uint32_t *volatile frame_active = frame_buf[0];   // 刷新中断正在扫描的帧
+static const uint32_t *volatile frame_pending = NULL;          // 已提交、等待下一帧开始时切换的帧
+static uint8_t current_slice = 0;
+static uint8_t current_plane = 0;
+
+static uint8_t brightness = LED_BRIGHTNESS_MAX;
+static uint8_t level_scale[LED_BRIGHTNESS_MAX + 1u];   // 单点亮度 → 叠加整帧亮度后的实际亮度
+static uint8_t level_atten[LED_MAX_ROWS][LED_MAX_COLS]; // 单点亮度相对最亮的衰减，默认0 = 最亮
+
+// 需要点亮（有效）的引脚 → BSRR 写入值
+static uint32_t LED_BsrrWord(uint16_t active)
+{
+    uint16_t high = (uint16_t)((active ^ active_low_mask) & all_mask);
+    return ((uint32_t)(all_mask & (uint16_t)~high) << 16) | high;
+}
+
+HAL_StatusTypeDef LED_Init(const LED_Geometry *geometry)
 {
-    if (htim->Instance == TIM2) {
-        if (current_row == 0) {
-            memcpy(vram_real, vram, sizeof(vram));
+    if (geometry == NULL) {
+        geometry = &LED_DefaultGeometry;
+    }
+    if (geometry->rows == 0 || geometry->rows > LED_MAX_ROWS
+        || geometry->cols == 0 || geometry->cols > LED_MAX_COLS) {
+        return HAL_ERROR;
+    }
+
+    uint16_t rows = 0;
+    uint16_t cols = 0;
+    for (uint8_t r = 0; r < geometry->rows; r++) {
+        row_mask[r] = geometry->row_pins[r];
+        rows |= geometry->row_pins[r];
+    }
+    for (uint8_t n = 0; n < 16; n++) {
+        col_mask_lo[n] = 0;
+        col_mask_hi[n] = 0;
+        for (uint8_t c = 0; c < geometry->cols; c++) {
+            if (c < 4 && (n & (1u << c))) {
+                col_mask_lo[n] |= geometry->col_pins[c];
+            } else if (c >= 4 && (n & (1u << (c - 4)))) {
+                col_mask_hi[n] |= geometry->col_pins[c];
+            }
         }
+    }
+    cols = (uint16_t)(col_mask_lo[15] | col_mask_hi[15]);
+
+    for (uint8_t b = 0; b < LED_BCM_BITS; b++) {
+        plane_arr[b] = (LED_BCM_UNIT_TICKS << b) - 1u;
+    }
+
+    led_port = geometry->port;
+    led_rows = geometry->rows;
+    led_cols = geometry->cols;
+    slice_count = (uint8_t)(geometry->rows * LED_BCM_BITS);
+    all_mask = (uint16_t)(rows | cols);
+    active_low_mask = (uint16_t)((geometry->row_active_high ? 0u : rows)
+                                 | (geometry->col_active_high ? 0u : cols));
+
+    // 两帧都填为全灭，刷新中断在第一次 LED_Present 之前也只输出熄灭
+    uint32_t off = LED_BsrrWord(0);
+    for (uint8_t i = 0; i < LED_MAX_SLICES; i++) {
+        frame_buf[0][i] = off;
+        frame_buf[1][i] = off;
+    }
+    frame_active = frame_buf[0];
+    frame_pending = NULL;
+    led_port->BSRR = off;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef LED_Start(TIM_HandleTypeDef *htim)
+{
+    if (slice_count == 0) {
+        return HAL_ERROR;   // 尚未 LED_Init
+    }
+    led_htim = htim;
+    current_slice = 0;
+    current_plane = 0;
+
+    // 产生更新事件立即装载第一片的长度，此后每次中断预装载下一片
+    __HAL_TIM_SET_AUTORELOAD(htim, plane_arr[0]);
+    htim->Instance->EGR = TIM_EGR_UG;
+    __HAL_TIM_CLEAR_FLAG(htim, TIM_FLAG_UPDATE);
+    return HAL_TIM_Base_Start_IT(htim);
+}
+
+void LED_SetBrightness(uint8_t level)
+{
+    if (level > LED_BRIGHTNESS_MAX) {
+        level = LED_BRIGHTNESS_MAX;
+    }
+    brightness = level;
+    for (uint8_t i = 0; i <= LED_BRIGHTNESS_MAX; i++) {
+        level_scale[i] = (uint8_t)((i * level + LED_BRIGHTNESS_MAX / 2u) / LED_BRIGHTNESS_MAX);
+    }
+}
+
+uint8_t LED_GetBrightness(void)
+{
+    return brightness;
+}
+
+HAL_StatusTypeDef LED_SetLevel(uint8_t row, uint8_t col, uint8_t level)
+{
+    // 按 LED_Init 配置的点阵检查，之外的单元永远不会显示
+    if (row >= led_rows || col >= led_cols) {
+        return HAL_ERROR;
+    }
+    if (level > LED_BRIGHTNESS_MAX) {
+        level = LED_BRIGHTNESS_MAX;
+    }
+    level_atten[row][col] = (uint8_t)(LED_BRIGHTNESS_MAX - level);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef LED_Present(void)
+{
+    // 上一帧还没被中断取走时不能改写后备缓冲
+    if (frame_pending != NULL) {
+        return HAL_BUSY;
+    }
+    if (level_scale[LED_BRIGHTNESS_MAX] != brightness) {
+        LED_SetBrightness(brightness);   // 首次调用时生成亮度表
+    }
+
+    uint32_t *frame = (frame_active == frame_buf[0]) ? frame_buf[1] : frame_buf[0];
 
-        // // 关闭所有行（PB6-PB15），防止重影
-        // for (uint8_t i = 6; i <= 15; i++) {
-        //     HAL_GPIO_WritePin(GPIOB, (1 << i), GPIO_PIN_RESET);
-        // }
+    for (uint8_t row = 0; row < led_rows; row++) {
+        uint8_t planes[LED_BCM_BITS] = {0};
+        uint8_t cols = vram[row];
 
-        // 刷新当前行的数据（设置PB0-PB5为当前行要显示的列状态）
-        for (uint8_t i = 0; i < 6; i++) {
-            HAL_GPIO_WritePin(GPIOB, (1 << i), (vram_real[current_row] & (1 << i)) ? GPIO_PIN_SET : GPIO_PIN_RESET);
+        for (uint8_t col = 0; col < led_cols; col++) {
+            if (cols & (1u << col)) {
+                uint8_t level = level_scale[LED_BRIGHTNESS_MAX - level_atten[row][col]];
+                for (uint8_t b = 0; b < LED_BCM_BITS; b++) {
+                    if (level & (1u << b)) {
+                        planes[b] |= (uint8_t)(1u << col);
+                    }
+                }
+            }
         }
 
-        // 点亮当前行（共阴极，接GND → 输出为0 → GPIO置为RESET）
-        // 例如 current_row = 0 → PB6
-        HAL_GPIO_WritePin(GPIOB, (1 << (current_row + 6)), GPIO_PIN_SET);
+        for (uint8_t b = 0; b < LED_BCM_BITS; b++) {
+            uint16_t active = 0;
+            if (planes[b]) {
+                active = (uint16_t)(row_mask[row] | col_mask_lo[planes[b] & 0x0Fu]
+                                    | col_mask_hi[planes[b] >> 4]);
+            }
+            frame[row * LED_BCM_BITS + b] = LED_BsrrWord(active);
+        }
+    }
 
-        // 下一行
-        current_row = (current_row + 1) % ROWS;
+    frame_pending = frame;
+    return HAL_OK;
+}
+
+void LED_UpdateDisplay(TIM_HandleTypeDef *htim)
+{
+    if (htim != led_htim) {
+        return;
     }
+    if (current_slice == 0 && frame_pending != NULL) {
+        frame_active = frame_pending;
+        frame_pending = NULL;
+    }
+
+    // 一次写入完成：熄灭上一片的行列，点亮当前行当前位平面的列，无中间态重影
+    led_port->BSRR = frame_active[current_slice];
+
+    if (++current_slice == slice_count) {
+        current_slice = 0;
+    }
+    if (++current_plane == LED_BCM_BITS) {
+        current_plane = 0;
+    }
+
+    // ARR 开启了预装载，此处写入的是下一个时间片的长度
+    htim->Instance->ARR = plane_arr[current_plane];
 }
@@ -0,0 +1,73 @@
+#include "log.h"
+#include "metrics.h"
+#include "telemetry.h"
+#include "trace.h"
+
+#define LOG_MASK (LOG_RING_WORDS - 1u)
+#define LOG_FRAME_WORDS ((TLM_MAX_PAYLOAD / 4u) - 1u)   // 每帧除丢弃计数外可放的记录字数
+
+static uint32_t ring[LOG_RING_WORDS];
+static volatile uint16_t log_head = 0;  // 只在关中断时写
+static volatile uint16_t log_tail = 0;  // 只由 LOG_Flush 写
+
+// log_records、log_dropped 只在关中断时写
+METRIC_COUNTER(log_records);
+METRIC_COUNTER(log_dropped);
+METRIC_COUNTER(log_frames);
+
+void LOG_Write(const uint32_t *rec)
+{
+    uint32_t nargs = rec[0] >> 16;
+    uint32_t len = 2u + nargs;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint16_t head = log_head;
+    if ((uint16_t)(head - log_tail) > LOG_RING_WORDS - len) {
+        METRIC_INC(log_dropped);
+        TRACE_Event(TRACE_OVERFLOW, TRACE_Q_LOG, (uint16_t)metric_log_dropped);
+        __set_PRIMASK(primask);
+        return;
+    }
+    ring[head & LOG_MASK] = rec[0];
+    ring[(head + 1u) & LOG_MASK] = DWT->CYCCNT;
+    for (uint32_t i = 1; i <= nargs; i++) {
+        ring[(head + 1u + i) & LOG_MASK] = rec[i];
+    }
+    log_head = (uint16_t)(head + len);
+    METRIC_INC(log_records);
+    __set_PRIMASK(primask);
+}
+
+void LOG_Flush(void)
+{
+    static uint32_t payload[1u + LOG_FRAME_WORDS];
+
+    while (1) {
+        uint16_t tail = log_tail;
+        uint16_t head = log_head;
+        uint32_t n = 0;
+
+        // 只取完整记录，记录在字环中绕回时逐字拷贝
+        while (tail != head) {
+            uint32_t len = 2u + (ring[tail & LOG_MASK] >> 16);
+            if (n + len > LOG_FRAME_WORDS) {
+                break;
+            }
+            for (uint32_t i = 0; i < len; i++) {
+                payload[1u + n + i] = ring[(uint16_t)(tail + i) & LOG_MASK];
+            }
+            n += len;
+            tail = (uint16_t)(tail + len);
+        }
+        if (n == 0) {
+            return;
+        }
+        payload[0] = metric_log_dropped;
+        if (TLM_Send(TLM_CH_LOG, payload, (uint16_t)((1u + n) * 4u)) != HAL_OK) {
+            return;     // 发送环已满，记录留在字环中下次再发
+        }
+        log_tail = tail;
+        METRIC_INC(log_frames);
+    }
+}
@@ -26,6 +26,28 @@
 
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "ntc.h"
+#include "display.h"
+#include "exti.h"
+#include "key.h"
+#include "scheduler.h"
+#include "swtimer.h"
+#include "defer.h"
+#include "irq.h"
+#include "tickless.h"
+#include "pt.h"
+#include "telemetry.h"
+#include "isrprof.h"
+#include "irqlat.h"
+#include "cpuload.h"
+#include "stack.h"
+#include "heap.h"
+#include "log.h"
+#include "metrics.h"
+#include "post.h"
+#include "trace.h"
+#include "crash.h"
+#include "mono.h"
 
 /* USER CODE END Includes */
 
@@ -58,6 +80,148 @@ void SystemClock_Config(void);
 
 /* Private user code ---------------------------------------------------------*/
 /* USER CODE BEGIN 0 */
+static volatile uint32_t temp_adc;      // 最近一次 ADC 采样，由 ADC 中断或超时写入
+static volatile uint8_t sample_done;    // 本次转换已完成
+static volatile int32_t temp_q4;        // 滤波后的温度，单位 0.1℃/16，只由 PendSV 写
+static volatile uint8_t temp_valid;     // temp_q4 已有初值
+
+static SCHED_Task task_sample;
+static PT pt_sample;
+
+METRIC_COUNTER(adc_timeouts);
+METRIC_GAUGE(temp_decic);       // 滤波后的温度，0.1℃
+
+static void Filter_Work(void *arg);
+static DEFER_Work filter_work = DEFER_WORK_INIT(Filter_Work, NULL);
+
+// 采样协程：以中断方式启动转换 → 等待完成（超时 100ms 记为 0，与 Read_Temperature 一致）
+// 结果由 ADC 中断读取并提交滤波，等待期间让出给其他任务
+static PT_THREAD(Sample_Thread(PT *pt))
+{
+  PT_BEGIN(pt);
+  sample_done = 0;
+  HAL_ADC_Start_IT(&hadc2);
+  pt->t0 = HAL_GetTick();
+  PT_WAIT_UNTIL(pt, sample_done || HAL_GetTick() - pt->t0 >= 100);
+  if (!sample_done) {
+    HAL_ADC_Stop_IT(&hadc2);
+    if (!sample_done) {     // 停止前的一瞬间完成时以中断的结果为准
+      temp_adc = 0;
+      METRIC_INC(adc_timeouts);
+      LOG_WARN("ADC conversion timeout");
+      DEFER_Post(&filter_work);
+    }
+  }
+  PT_END(pt);
+}
+
+// ADC 转换完成（抢占 2）：只取结果，换算和滤波延后到 PendSV，中断本身保持很短
+void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef *hadc)
+{
+  temp_adc = HAL_ADC_GetValue(hadc);
+  sample_done = 1;
+  DEFER_Post(&filter_work);
+}
+
+// 采样：每 100ms 释放一次，协程未结束时提交自己尽快继续（不影响周期释放）
+static void Task_Sample(void)
+{
+  if (Sample_Thread(&pt_sample) != PT_ENDED) {
+    SCHED_Post(&task_sample);
+  }
+}
+
+// 滤波（PendSV 延后工作）：NTC 换算 + 一阶 IIR，新样本权重 1/4；传感器开路/短路时不更新
+static void Filter_Work(void *arg)
+{
+  (void)arg;
+  uint32_t adc = temp_adc;
+  if (adc == 0 || adc >= 4095) {
+    if (temp_valid) {
+      LOG_WARN("NTC fault, adc %u", adc);
+    }
+    temp_valid = 0;
+    return;
+  }
+  float temp = NTC_ConvertToCelsius(adc);
+  LOG_DEBUG("adc %u -> %.2f C", adc, LOG_F(temp));
+  int32_t sample_q4 = (int32_t)(temp * 160.0f + (temp < 0 ? -0.5f : 0.5f));
+  if (!temp_valid) {
+    temp_q4 = sample_q4;
+    temp_valid = 1;
+  } else {
+    temp_q4 += (sample_q4 - temp_q4) / 4;
+  }
+  METRIC_SET(temp_decic, (temp_q4 + (temp_q4 < 0 ? -8 : 8)) / 16);
+}
+
+// 显示：温度字段，ADC 满量程/零点分别对应传感器短路/开路
+static void Task_Render(void)
+{
+  uint32_t adc = temp_adc;
+  int32_t q4 = temp_q4;
+  if (adc == 0) {
+    DISP_SetGlyph(DISP_FIELD_TEMP, SEG7_GLYPH_OPEN);
+  } else if (adc >= 4095) {
+    DISP_SetGlyph(DISP_FIELD_TEMP, SEG7_GLYPH_SHORT);
+  } else if (temp_valid) {
+    DISP_SetFixed(DISP_FIELD_TEMP, (q4 + (q4 < 0 ? -8 : 8)) / 16, 1);
+  }
+  DISP_SetGlyph(DISP_FIELD_FLOW, SEG7_GLYPH_NONE);
+  DISP_Flush();
+}
+
+static SCHED_Task task_trace;
+
+// 跟踪转储：冻结事件环并分帧发送，发送环满时 10ms 后继续，发完恢复记录；长按或故障复位后提交
+static void Task_Trace(void)
+{
+  HAL_StatusTypeDef status = TRACE_Dump();
+  if (status == HAL_BUSY) {
+    SCHED_Arm(&task_trace, 10);
+  } else if (status == HAL_OK) {
+    TRACE_Resume();
+  }
+}
+
+// 输入：短按循环调低亮度，到 0 后回到最亮；长按转储事件跟踪
+static void Task_Input(void)
+{
+  KEY_Event key;
+  EXTI_Event edge;
+
+  while ((key = KEY_GetEvent()) != KEY_EVENT_NONE) {
+    if (key == KEY_EVENT_PRESS) {
+      uint8_t level = LED_GetBrightness();
+      DISP_SetBrightness(level == 0 ? LED_BRIGHTNESS_MAX : level - 1u);
+    } else if (key == KEY_EVENT_LONG) {
+      TRACE_Freeze();   // 先冻结，保留长按之前的时间线
+      SCHED_Post(&task_trace);
+    }
+  }
+  while (EXTI_GetEvent(&edge)) {
+    // PA8 边沿暂无业务处理，取出以免队列溢出
+  }
+}
+
+// 遥测：每秒发送一次 CPU 占用、栈高水位、堆（有变化时）、指标快照、中断耗时与定时器中断延迟统计
+static void Task_Report(void)
+{
+  LOAD_Dump();
+  STACK_Dump();
+  HEAP_Dump();
+  METRIC_Dump();
+  PROF_Dump();
+  LAT_Dump();
+}
+
+static SCHED_Task task_input  = {.name = "input",  .run = Task_Input,  .period_ms = 10,  .priority = 0};
+static SCHED_Task task_sample = {.name = "sample", .run = Task_Sample, .period_ms = 100, .deadline_ms = 5,  .priority = 1};
+static SCHED_Task task_render = {.name = "render", .run = Task_Render, .period_ms = 100, .deadline_ms = 20, .priority = 3};
+static SCHED_Task task_report = {.name = "report", .run = Task_Report, .period_ms = 1000, .priority = 4};
+static SCHED_Task task_trace  = {.name = "trace",  .run = Task_Trace,  .priority = 5};   // 长按或故障复位后提交
+static SCHED_Task task_log    = {.name = "log",    .run = LOG_Flush,   .period_ms = 50,  .priority = 5};
+static SCHED_Task task_timer  = {.name = "timer",  .run = SWT_Process, .priority = 0};   // 由 SWT_ExpiredCallback 唤醒
 
 /* USER CODE END 0 */
 
@@ -69,7 +233,7 @@ int main(void)
 {
 
   /* USER CODE BEGIN 1 */
-
+  CRASH_Init();     // 先于 HAL_Init，SysTick 开始后中断会写入事件环
   /* USER CODE END 1 */
 
   /* MCU Configuration--------------------------------------------------------*/
@@ -85,7 +249,12 @@ int main(void)
   SystemClock_Config();
 
   /* USER CODE BEGIN SysInit */
-
+  // 尽早开启 DWT 周期计数器：POST、日志、事件跟踪和 ISR 剖析的时间戳都取自 CYCCNT；
+  // HCLK 与 MONO_CPU_HZ 不一致时所有周期换算都是错的，不能带病运行
+  if (MONO_Init() != 0)
+  {
+    Error_Handler();
+  }
   /* USER CODE END SysInit */
 
   /* Initialize all configured peripherals */
@@ -93,7 +262,36 @@ int main(void)
   MX_ADC2_Init();
   MX_TIM2_Init();
   /* USER CODE BEGIN 2 */
-  HAL_TIM_Base_Start_IT(&htim2);
+  IRQ_Init();
+  DEFER_Init();
+  TLM_Init();
+  if (LED_Init(NULL) != HAL_OK || LED_Start(&htim2) != HAL_OK)
+  {
+    Error_Handler();
+  }
+  POST_Run();   // 结果记入指标块，超限只告警不停机
+  DISP_Init();
+
+  SWT_Init();
+  SCHED_Init();
+  SCHED_Add(&task_timer);
+  SCHED_Add(&task_input);
+  SCHED_Add(&task_sample);
+  SCHED_Add(&task_render);
+  SCHED_Add(&task_report);
+  SCHED_Add(&task_log);
+  SCHED_Add(&task_trace);
+  SCHED_Arm(&task_input, 0);
+  SCHED_Arm(&task_sample, 0);
+  SCHED_Arm(&task_render, 4);   // 错开相位：采样 → （ADC 中断、PendSV 滤波）→ 显示
+  SCHED_Arm(&task_report, 1000);
+  SCHED_Arm(&task_log, 50);
+  LOAD_Init();
+  HEAP_Seal();    // 此后主循环不应再扩展堆
+  LOG_INFO("boot, core %u Hz", SystemCoreClock);
+  if (CRASH_Report()) {
+    SCHED_Post(&task_trace);    // 发送故障前的事件时间线
+  }
   /* USER CODE END 2 */
 
   /* Infinite loop */
@@ -101,9 +299,9 @@ int main(void)
   while (1)
   {
     /* USER CODE END WHILE */
-    //ntc();
-    vram[0] = 0b0000001;
+
     /* USER CODE BEGIN 3 */
+    SCHED_Run();
   }
   /* USER CODE END 3 */
 }
@@ -155,6 +353,20 @@ void SystemClock_Config(void)
 }
 
 /* USER CODE BEGIN 4 */
+void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
+{
+  LED_UpdateDisplay(htim);
+}
+
+void SWT_ExpiredCallback(void)
+{
+  SCHED_Post(&task_timer);
+}
+
+void SCHED_Idle(uint32_t idle_ms)
+{
+  TICKLESS_Idle(idle_ms);
+}
 
 /* USER CODE END 4 */
 
@@ -167,6 +379,7 @@ void Error_Handler(void)
   /* USER CODE BEGIN Error_Handler_Debug */
   /* User can add his own implementation to report the HAL error return state */
   __disable_irq();
+  TRACE_Freeze();
   while (1)
   {
   }
@@ -0,0 +1,49 @@
+#include "metrics.h"
+#include "telemetry.h"
+
+#define METRIC_CHUNK (TLM_MAX_PAYLOAD - sizeof(METRIC_Header))
+
+extern uint32_t _smetrics;          // 链接脚本定义
+extern uint32_t _emetrics;
+
+// 快照缓冲：块大小在链接时才确定，按上限预留，超出上限时链接失败
+static uint32_t snapshot[METRIC_BLOCK_MAX / 4u];
+static struct __attribute__((packed)) {
+    METRIC_Header header;
+    uint8_t data[METRIC_CHUNK];
+} frame;
+static uint32_t sequence = 0;
+
+void METRIC_Dump(void)
+{
+    const uint32_t *src = &_smetrics;
+    const uint32_t words = (uint32_t)(&_emetrics - &_smetrics);
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    for (uint32_t i = 0; i < words; i++) {
+        snapshot[i] = src[i];
+    }
+    __set_PRIMASK(primask);
+
+    frame.header.base = (uint32_t)(uintptr_t)src;
+    frame.header.sequence = sequence++;
+    frame.header.offset = 0;
+    frame.header.total = (uint16_t)(words * 4u);
+
+    const uint8_t *bytes = (const uint8_t *)snapshot;
+    do {
+        uint16_t offset = frame.header.offset;
+        uint16_t len = (uint16_t)(frame.header.total - offset);
+        if (len > METRIC_CHUNK) {
+            len = METRIC_CHUNK;
+        }
+        for (uint16_t i = 0; i < len; i++) {
+            frame.data[i] = bytes[offset + i];
+        }
+        if (TLM_Send(TLM_CH_METRICS, &frame, (uint16_t)(sizeof(METRIC_Header) + len)) != HAL_OK) {
+            return;     // 发送环已满，放弃本次快照的剩余部分
+        }
+        frame.header.offset = (uint16_t)(offset + len);
+    } while (frame.header.offset < frame.header.total);
+}
@@ -0,0 +1,67 @@
+#if !defined(__arm__) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L     // 主机实现需要 clock_gettime
+#endif
+
+#include "mono.h"
+
+#if MONO_CPU_HZ != 72000000u
+#error "MONO_CyclesToNs 按 72MHz 写死了 125/9，修改 MONO_CPU_HZ 时一并修改"
+#endif
+
+#if defined(__arm__)
+
+#include "main.h"
+
+static uint32_t cycles_high = 0;
+static uint32_t cycles_last = 0;
+
+int MONO_Init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    if (!(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk)) {
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+    return SystemCoreClock == MONO_CPU_HZ ? 0 : -1;
+}
+
+uint64_t MONO_Cycles(void)
+{
+    // 读与扩展须原子完成；M3 没有 64 位独占访问，关中断只有几条指令
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint32_t now = DWT->CYCCNT;
+    if (now < cycles_last) {
+        cycles_high++;
+    }
+    cycles_last = now;
+    uint64_t cycles = ((uint64_t)cycles_high << 32) | now;
+    __set_PRIMASK(primask);
+    return cycles;
+}
+
+#else
+
+#include <time.h>
+
+static uint64_t host_origin_ns = 0;
+
+static uint64_t MONO_HostNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+int MONO_Init(void)
+{
+    host_origin_ns = MONO_HostNs();
+    return 0;
+}
+
+uint64_t MONO_Cycles(void)
+{
+    return (MONO_HostNs() - host_origin_ns) * 9u / 125u;
+}
+
+#endif
@@ -0,0 +1,160 @@
+#include "post.h"
+#include "led.h"
+#include "log.h"
+#include "metrics.h"
+#include "ntc.h"
+#include "seg7.h"
+#include "tim.h"
+
+METRIC_GAUGE(post_ntc_cycles);
+METRIC_GAUGE(post_format_cycles);
+METRIC_GAUGE(post_encode_cycles);
+METRIC_GAUGE(post_refresh_cycles);
+METRIC_GAUGE(post_fail_mask);
+
+static uint32_t results[POST_COUNT];
+
+#if POST_ENABLE
+
+static const uint32_t limits[POST_COUNT] = {
+    [POST_NTC] = POST_LIMIT_NTC,
+    [POST_FORMAT] = POST_LIMIT_FORMAT,
+    [POST_ENCODE] = POST_LIMIT_ENCODE,
+    [POST_REFRESH] = POST_LIMIT_REFRESH,
+};
+
+// 固定输入：覆盖低温、常温、高温三段
+static const uint32_t ntc_inputs[] = {512u, 2048u, 3500u};
+
+static volatile float sink_f;           // 防止被测结果被优化掉
+static uint8_t sink_cells[LED_MAX_ROWS];
+
+static void Kernel_None(uint32_t i)
+{
+    (void)i;
+}
+
+static void Kernel_Ntc(uint32_t i)
+{
+    sink_f = NTC_ConvertToCelsius(ntc_inputs[i % (sizeof(ntc_inputs) / sizeof(ntc_inputs[0]))]);
+}
+
+static void Kernel_Format(uint32_t i)
+{
+    SEG7_FormatFixed(sink_cells, 3, (i & 1u) ? -45 : 876, 1);
+}
+
+static void Kernel_Encode(uint32_t i)
+{
+    (void)i;
+    LED_Present();
+}
+
+static void Kernel_Refresh(uint32_t i)
+{
+    (void)i;
+    LED_UpdateDisplay(&htim2);
+}
+
+// 关中断计时一次，返回 CYCCNT 差值
+static uint32_t POST_Time(void (*kernel)(uint32_t), uint32_t arg)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint32_t start = DWT->CYCCNT;
+    kernel(arg);
+    uint32_t cycles = DWT->CYCCNT - start;
+    __set_PRIMASK(primask);
+    return cycles;
+}
+
+static void POST_Update(uint32_t *worst, uint32_t cycles, uint32_t overhead)
+{
+    cycles = cycles > overhead ? cycles - overhead : 0u;
+    if (cycles > *worst) {
+        *worst = cycles;
+    }
+}
+
+// 跑满一帧的时间片（LED_MAX_SLICES 不少于实际片数，必经过第 0 片），使已提交的帧被取走
+static void POST_RefreshFrame(uint32_t *worst, uint32_t overhead)
+{
+    for (uint32_t k = 0; k < LED_MAX_SLICES; k++) {
+        POST_Update(worst, POST_Time(Kernel_Refresh, k), overhead);
+    }
+}
+
+uint32_t POST_Run(void)
+{
+    uint32_t worst[POST_COUNT] = {0};
+    uint32_t overhead = UINT32_MAX;
+    uint8_t saved[LED_MAX_ROWS];
+
+    HAL_NVIC_DisableIRQ(TIM2_IRQn);
+
+    for (uint32_t i = 0; i < POST_ROUNDS; i++) {
+        uint32_t cycles = POST_Time(Kernel_None, i);
+        if (cycles < overhead) {
+            overhead = cycles;
+        }
+    }
+    for (uint32_t i = 0; i < POST_ROUNDS; i++) {
+        POST_Update(&worst[POST_NTC], POST_Time(Kernel_Ntc, i), overhead);
+        POST_Update(&worst[POST_FORMAT], POST_Time(Kernel_Format, i), overhead);
+    }
+
+    // 编码最坏情况：全部段点亮
+    for (uint8_t r = 0; r < LED_MAX_ROWS; r++) {
+        saved[r] = vram[r];
+        vram[r] = 0xFFu;
+    }
+    POST_RefreshFrame(&worst[POST_REFRESH], overhead);
+    for (uint32_t i = 0; i < POST_ROUNDS; i++) {
+        POST_Update(&worst[POST_ENCODE], POST_Time(Kernel_Encode, i), overhead);
+        POST_RefreshFrame(&worst[POST_REFRESH], overhead);
+    }
+    for (uint8_t r = 0; r < LED_MAX_ROWS; r++) {
+        vram[r] = saved[r];
+    }
+    LED_Present();
+    POST_RefreshFrame(&worst[POST_REFRESH], overhead);
+
+    __HAL_TIM_CLEAR_FLAG(&htim2, TIM_FLAG_UPDATE);
+    HAL_NVIC_EnableIRQ(TIM2_IRQn);
+
+    uint32_t fail = 0;
+    if (overhead == 0) {
+        // 空计时至少也要几个周期，为 0 说明 CYCCNT 没有运行（未先调用 MONO_Init），各项结果无效
+        fail = (1u << POST_COUNT) - 1u;
+        LOG_ERROR("POST: DWT cycle counter stopped");
+    }
+    for (uint32_t k = 0; k < POST_COUNT; k++) {
+        results[k] = worst[k];
+        if (worst[k] > limits[k]) {
+            fail |= 1u << k;
+            LOG_WARN("POST kernel %u: %u cycles > limit %u", k, worst[k], limits[k]);
+        }
+    }
+    METRIC_SET(post_ntc_cycles, worst[POST_NTC]);
+    METRIC_SET(post_format_cycles, worst[POST_FORMAT]);
+    METRIC_SET(post_encode_cycles, worst[POST_ENCODE]);
+    METRIC_SET(post_refresh_cycles, worst[POST_REFRESH]);
+    METRIC_SET(post_fail_mask, fail);
+    LOG_INFO("POST ntc %u format %u encode %u refresh %u cycles",
+             worst[POST_NTC], worst[POST_FORMAT], worst[POST_ENCODE], worst[POST_REFRESH]);
+    return fail;
+}
+
+#else
+
+uint32_t POST_Run(void)
+{
+    return 0;
+}
+
+#endif // POST_ENABLE
+
+uint32_t POST_GetCycles(POST_Kernel kernel)
+{
+    return (kernel < POST_COUNT) ? results[kernel] : 0u;
+}
@@ -0,0 +1,177 @@
+#include "scheduler.h"
+#include "mono.h"
+#include "cpuload.h"
+#include "metrics.h"
+#include "trace.h"
+
+static SCHED_Task *tasks[SCHED_MAX_TASKS];
+static uint8_t task_count = 0;
+static volatile uint8_t any_posted = 0;   // 有任务被 SCHED_Post，避免休眠
+static SCHED_Task *volatile current = NULL;
+
+METRIC_COUNTER(sched_misses);           // 全部任务错过截止时间的总次数
+METRIC_HISTOGRAM(sched_run_us, 16);     // 任务单次运行耗时（us，按 2 的幂分桶）
+
+void SCHED_Init(void)
+{
+    task_count = 0;
+    any_posted = 0;
+}
+
+HAL_StatusTypeDef SCHED_Add(SCHED_Task *task)
+{
+    if (task_count >= SCHED_MAX_TASKS) {
+        return HAL_ERROR;
+    }
+    task->id = task_count;
+    task->armed = 0;
+    task->posted = 0;
+    tasks[task_count++] = task;
+    return HAL_OK;
+}
+
+void SCHED_Arm(SCHED_Task *task, uint32_t delay_ms)
+{
+    task->release = HAL_GetTick() + delay_ms;
+    task->armed = 1;
+}
+
+void SCHED_Cancel(SCHED_Task *task)
+{
+    task->armed = 0;
+    task->posted = 0;
+}
+
+void SCHED_Post(SCHED_Task *task)
+{
+    task->posted = 1;
+    any_posted = 1;
+}
+
+const SCHED_Task *SCHED_GetTask(uint8_t id)
+{
+    return (id < task_count) ? tasks[id] : NULL;
+}
+
+const SCHED_Task *SCHED_Current(void)
+{
+    return current;
+}
+
+uint8_t SCHED_Pending(void)
+{
+    return any_posted;
+}
+
+// 任务的绝对截止时间
+static uint32_t SCHED_Deadline(const SCHED_Task *task)
+{
+    uint32_t deadline = task->deadline_ms ? task->deadline_ms : task->period_ms;
+    return task->release + deadline;
+}
+
+// 选出就绪任务中优先级最高、截止时间最早的一个
+static SCHED_Task *SCHED_Pick(uint32_t now)
+{
+    SCHED_Task *best = NULL;
+
+    any_posted = 0;
+    for (uint8_t i = 0; i < task_count; i++) {
+        SCHED_Task *task = tasks[i];
+        if (task->posted) {
+            any_posted = 1;     // 仍有未运行的 Post，本轮不能休眠
+        } else if (!task->armed || (int32_t)(now - task->release) < 0) {
+            continue;
+        }
+        if (best == NULL || task->priority < best->priority
+            || (task->priority == best->priority
+                && (int32_t)(SCHED_Deadline(task) - SCHED_Deadline(best)) < 0)) {
+            best = task;
+        }
+    }
+    return best;
+}
+
+static void SCHED_Execute(SCHED_Task *task, uint32_t now)
+{
+    uint8_t by_post = task->posted && !(task->armed && (int32_t)(now - task->release) >= 0);
+    uint32_t start = DWT->CYCCNT;
+
+    task->posted = 0;
+    current = task;
+    TRACE_Event(TRACE_TASK_START, task->id, 0);
+    task->run();
+    TRACE_Event(TRACE_TASK_END, task->id, 0);
+    current = NULL;
+
+    uint32_t cycles = DWT->CYCCNT - start;
+    uint32_t done = HAL_GetTick();
+    SCHED_Stats *stats = &task->stats;
+    stats->runs++;
+    stats->cycles_last = cycles;
+    stats->cycles_total += cycles;
+    if (cycles > stats->cycles_max) {
+        stats->cycles_max = cycles;
+    }
+    METRIC_OBSERVE(sched_run_us, cycles / (MONO_CPU_HZ / 1000000u));
+
+    if (by_post) {
+        return;     // Post 触发的运行不影响周期释放
+    }
+    if ((task->period_ms || task->deadline_ms) && (int32_t)(done - SCHED_Deadline(task)) > 0) {
+        stats->misses++;
+        METRIC_INC(sched_misses);
+    }
+    if (task->period_ms == 0) {
+        task->armed = 0;
+        return;
+    }
+    // 保持相位；超时跨过的周期直接跳过并计为错过
+    task->release += task->period_ms;
+    while ((int32_t)(done - task->release) >= (int32_t)task->period_ms) {
+        task->release += task->period_ms;
+        stats->misses++;
+        METRIC_INC(sched_misses);
+    }
+}
+
+// 距最早的已安排任务释放的时间
+static uint32_t SCHED_IdleTime(uint32_t now)
+{
+    uint32_t idle = UINT32_MAX;
+
+    for (uint8_t i = 0; i < task_count; i++) {
+        if (tasks[i]->armed) {
+            int32_t left = (int32_t)(tasks[i]->release - now);
+            uint32_t ms = left > 0 ? (uint32_t)left : 0u;
+            if (ms < idle) {
+                idle = ms;
+            }
+        }
+    }
+    return idle;
+}
+
+__weak void SCHED_Idle(uint32_t idle_ms)
+{
+    (void)idle_ms;
+    LOAD_Wfi();
+}
+
+void SCHED_Run(void)
+{
+    uint32_t now = HAL_GetTick();
+    SCHED_Task *task = SCHED_Pick(now);
+
+    if (task != NULL) {
+        SCHED_Execute(task, now);
+        return;
+    }
+
+    // 关中断后再确认没有 Post：挂起的中断仍能唤醒 WFI，不会错过
+    __disable_irq();
+    if (!any_posted) {
+        SCHED_Idle(SCHED_IdleTime(HAL_GetTick()));
+    }
+    __enable_irq();
+}
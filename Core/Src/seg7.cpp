@@ -0,0 +1,160 @@
+#include "seg7.h"
+
+namespace {
+
+// 抽象段位：bit0–bit6 为 a–g，bit7 为 dp
+enum : uint8_t {
+    A = 1u << 0, B = 1u << 1, C = 1u << 2, D = 1u << 3,
+    E = 1u << 4, F = 1u << 5, G = 1u << 6, DP = 1u << 7,
+};
+
+constexpr uint16_t kSegPins[8] = {
+    SEG7_A_Pin, SEG7_B_Pin, SEG7_C_Pin, SEG7_D_Pin,
+    SEG7_E_Pin, SEG7_F_Pin, SEG7_G_Pin, SEG7_DP_Pin,
+};
+
+// 默认几何的列引脚，下标即 vram 中的列位
+constexpr uint16_t kColPins[] = {LED_DEFAULT_COL_PINS};
+constexpr uint8_t kColCount = sizeof(kColPins) / sizeof(kColPins[0]);
+
+// 段引脚在列引脚表中的序号，不是列引脚时返回 kColCount
+constexpr uint8_t column_of(uint16_t pin)
+{
+    uint8_t n = 0;
+    while (n < kColCount && kColPins[n] != pin) {
+        n++;
+    }
+    return n;
+}
+
+constexpr uint8_t encode(uint8_t segs)
+{
+    uint8_t bits = 0;
+    for (uint8_t i = 0; i < 8; i++) {
+        if (segs & (1u << i)) {
+            bits |= (uint8_t)(1u << column_of(kSegPins[i]));
+        }
+    }
+    return bits;
+}
+
+constexpr bool segment_pins_valid()
+{
+    uint16_t seen = 0;
+    for (uint16_t pin : kSegPins) {
+        if (column_of(pin) >= kColCount || column_of(pin) >= 8 || (pin & seen) != 0) {
+            return false;
+        }
+        seen |= pin;
+    }
+    return true;
+}
+
+static_assert(segment_pins_valid(), "SEG7_x_Pin 必须是互不相同的单个列引脚");
+
+// 按 SEG7_Glyph 顺序排列
+constexpr uint8_t kGlyphs[][3] = {
+    {SEG7_CHAR_MINUS, SEG7_CHAR_MINUS, SEG7_CHAR_MINUS},   // ---
+    {SEG7_CHAR_E, SEG7_CHAR_r, SEG7_CHAR_r},               // Err
+    {SEG7_CHAR_O, SEG7_CHAR_P, SEG7_CHAR_n},               // OPn
+    {SEG7_CHAR_S, SEG7_CHAR_h, SEG7_CHAR_t},               // Sht
+};
+
+} // namespace
+
+extern "C" const uint8_t SEG7_Font[SEG7_CHAR_COUNT] = {
+    encode(A | B | C | D | E | F),      // 0
+    encode(B | C),                      // 1
+    encode(A | B | D | E | G),          // 2
+    encode(A | B | C | D | G),          // 3
+    encode(B | C | F | G),              // 4
+    encode(A | C | D | F | G),          // 5
+    encode(A | C | D | E | F | G),      // 6
+    encode(A | B | C),                  // 7
+    encode(A | B | C | D | E | F | G),  // 8
+    encode(A | B | C | D | F | G),      // 9
+    encode(0),                          // 空白
+    encode(G),                          // -
+    encode(A | D | E | F | G),          // E
+    encode(E | G),                      // r
+    encode(A | B | C | D | E | F),      // O
+    encode(A | B | E | F | G),          // P
+    encode(C | E | G),                  // n
+    encode(A | C | D | F | G),          // S
+    encode(C | E | F | G),              // h
+    encode(D | E | F | G),              // t
+};
+
+extern "C" const uint8_t SEG7_DpBits = encode(DP);
+
+HAL_StatusTypeDef SEG7_FormatFixed(uint8_t *cells, uint8_t width, int32_t value, uint8_t frac)
+{
+    uint32_t mag = (value < 0) ? 0u - (uint32_t)value : (uint32_t)value;
+    uint8_t i = width;
+    uint8_t digits = 0;
+
+    // 从最低位开始填，至少保留 frac + 1 位数字（0.5 而不是 .5）
+    while (i > 0 && (mag != 0 || digits <= frac)) {
+        cells[--i] = (uint8_t)(mag % 10u);
+        mag /= 10u;
+        digits++;
+    }
+    if (mag != 0 || digits <= frac || (value < 0 && i == 0)) {
+        SEG7_FormatGlyph(cells, width, SEG7_GLYPH_ERR);
+        return HAL_ERROR;
+    }
+
+    if (frac > 0) {
+        cells[width - 1u - frac] |= SEG7_CELL_DP;
+    }
+    if (value < 0) {
+        cells[--i] = SEG7_CHAR_MINUS;
+    }
+    while (i > 0) {
+        cells[--i] = SEG7_CHAR_BLANK;
+    }
+    return HAL_OK;
+}
+
+void SEG7_FormatGlyph(uint8_t *cells, uint8_t width, SEG7_Glyph glyph)
+{
+    const uint8_t *text = kGlyphs[glyph];
+    uint8_t pad = (width > 3u && glyph != SEG7_GLYPH_NONE) ? (uint8_t)(width - 3u) : 0u;
+
+    for (uint8_t i = 0; i < width; i++) {
+        if (i < pad) {
+            cells[i] = SEG7_CHAR_BLANK;
+        } else if (i - pad < 3) {
+            cells[i] = text[i - pad];
+        } else {
+            cells[i] = SEG7_CHAR_MINUS;
+        }
+    }
+}
+
+HAL_StatusTypeDef SEG7_WriteFixed(uint8_t row, uint8_t width, int32_t value, uint8_t frac)
+{
+    uint8_t cells[LED_MAX_ROWS];
+
+    if (row >= LED_MAX_ROWS || width > LED_MAX_ROWS - row) {
+        return HAL_ERROR;
+    }
+    HAL_StatusTypeDef status = SEG7_FormatFixed(cells, width, value, frac);
+    for (uint8_t i = 0; i < width; i++) {
+        vram[row + i] = SEG7_Encode(cells[i]);
+    }
+    return status;
+}
+
+void SEG7_WriteGlyph(uint8_t row, uint8_t width, SEG7_Glyph glyph)
+{
+    uint8_t cells[LED_MAX_ROWS];
+
+    if (row >= LED_MAX_ROWS || width > LED_MAX_ROWS - row) {
+        return;
+    }
+    SEG7_FormatGlyph(cells, width, glyph);
+    for (uint8_t i = 0; i < width; i++) {
+        vram[row + i] = SEG7_Encode(cells[i]);
+    }
+}
@@ -0,0 +1,42 @@
+#include "stack.h"
+#include "heap.h"
+#include "telemetry.h"
+
+extern uint32_t _estack;            // 链接脚本定义
+extern uint32_t _Min_Stack_Size;
+extern uint8_t _end;
+
+static const uint32_t *mark = NULL; // 已知被改写的最低地址
+
+void STACK_GetStats(STACK_Stats *out)
+{
+    const uint32_t size = (uint32_t)&_Min_Stack_Size;
+    const uint32_t *top = &_estack;
+    HEAP_Stats heap;
+
+    HEAP_GetStats(&heap);
+    // 堆顶峰值以下的涂色已被堆改写，从其上第一个整字开始
+    const uint32_t *floor = (const uint32_t *)(((uint32_t)&_end + heap.brk_peak + 3u) & ~3u);
+
+    if (mark == NULL) {
+        mark = top;
+    }
+    const uint32_t *p = floor;
+    while (p < mark && *p == STACK_PAINT) {
+        p++;
+    }
+    if (p < mark) {     // 堆顶峰值已越过原水位时保留原值
+        mark = p;
+    }
+
+    out->size = size;
+    out->used = (uint32_t)((const uint8_t *)top - (const uint8_t *)mark);
+    out->overflow = out->used > size ? 1u : 0u;
+}
+
+void STACK_Dump(void)
+{
+    STACK_Report report;
+    STACK_GetStats(&report);
+    TLM_Send(TLM_CH_STACK, &report, sizeof(report));
+}
@@ -22,6 +22,14 @@
 #include "stm32f1xx_it.h"
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "key.h"
+#include "swtimer.h"
+#include "defer.h"
+#include "mono.h"
+#include "isrprof.h"
+#include "irqlat.h"
+#include "telemetry.h"
+#include "crash.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -57,6 +65,7 @@
 /* External variables --------------------------------------------------------*/
 extern TIM_HandleTypeDef htim2;
 /* USER CODE BEGIN EV */
+extern ADC_HandleTypeDef hadc2;
 
 /* USER CODE END EV */
 
@@ -84,7 +93,7 @@ void NMI_Handler(void)
 void HardFault_Handler(void)
 {
   /* USER CODE BEGIN HardFault_IRQn 0 */
-
+  CRASH_CAPTURE();   // 保存现场并复位，不返回
   /* USER CODE END HardFault_IRQn 0 */
   while (1)
   {
@@ -99,7 +108,7 @@ void HardFault_Handler(void)
 void MemManage_Handler(void)
 {
   /* USER CODE BEGIN MemoryManagement_IRQn 0 */
-
+  CRASH_CAPTURE();   // 保存现场并复位，不返回
   /* USER CODE END MemoryManagement_IRQn 0 */
   while (1)
   {
@@ -114,7 +123,7 @@ void MemManage_Handler(void)
 void BusFault_Handler(void)
 {
   /* USER CODE BEGIN BusFault_IRQn 0 */
-
+  CRASH_CAPTURE();   // 保存现场并复位，不返回
   /* USER CODE END BusFault_IRQn 0 */
   while (1)
   {
@@ -129,7 +138,7 @@ void BusFault_Handler(void)
 void UsageFault_Handler(void)
 {
   /* USER CODE BEGIN UsageFault_IRQn 0 */
-
+  CRASH_CAPTURE();   // 保存现场并复位，不返回
   /* USER CODE END UsageFault_IRQn 0 */
   while (1)
   {
@@ -170,7 +179,9 @@ void DebugMon_Handler(void)
 void PendSV_Handler(void)
 {
   /* USER CODE BEGIN PendSV_IRQn 0 */
-
+  PROF_ENTER(PROF_PENDSV);
+  DEFER_Handler();
+  PROF_EXIT(PROF_PENDSV);
   /* USER CODE END PendSV_IRQn 0 */
   /* USER CODE BEGIN PendSV_IRQn 1 */
 
@@ -183,11 +194,14 @@ void PendSV_Handler(void)
 void SysTick_Handler(void)
 {
   /* USER CODE BEGIN SysTick_IRQn 0 */
-
+  PROF_ENTER(PROF_SYSTICK);
   /* USER CODE END SysTick_IRQn 0 */
   HAL_IncTick();
   /* USER CODE BEGIN SysTick_IRQn 1 */
-
+  MONO_Tick();
+  KEY_Tick();
+  SWT_Tick();
+  PROF_EXIT(PROF_SYSTICK);
   /* USER CODE END SysTick_IRQn 1 */
 }
 
@@ -204,14 +218,62 @@ void SysTick_Handler(void)
 void TIM2_IRQHandler(void)
 {
   /* USER CODE BEGIN TIM2_IRQn 0 */
-
+  LAT_TIMER_ENTRY(TIM2);
+  PROF_ENTER(PROF_TIM2);
   /* USER CODE END TIM2_IRQn 0 */
   HAL_TIM_IRQHandler(&htim2);
   /* USER CODE BEGIN TIM2_IRQn 1 */
-
+  PROF_EXIT(PROF_TIM2);
   /* USER CODE END TIM2_IRQn 1 */
 }
 
+/**
+  * @brief This function handles EXTI line[9:5] interrupts.
+  */
+void EXTI9_5_IRQHandler(void)
+{
+  /* USER CODE BEGIN EXTI9_5_IRQn 0 */
+  PROF_ENTER(PROF_EXTI9_5);
+  /* USER CODE END EXTI9_5_IRQn 0 */
+  HAL_GPIO_EXTI_IRQHandler(LED_Pin);
+  /* USER CODE BEGIN EXTI9_5_IRQn 1 */
+  PROF_EXIT(PROF_EXTI9_5);
+  /* USER CODE END EXTI9_5_IRQn 1 */
+}
+
+/**
+  * @brief This function handles EXTI line[15:10] interrupts.
+  */
+void EXTI15_10_IRQHandler(void)
+{
+  /* USER CODE BEGIN EXTI15_10_IRQn 0 */
+  PROF_ENTER(PROF_EXTI15_10);
+  /* USER CODE END EXTI15_10_IRQn 0 */
+  HAL_GPIO_EXTI_IRQHandler(KEY_Pin);
+  /* USER CODE BEGIN EXTI15_10_IRQn 1 */
+  PROF_EXIT(PROF_EXTI15_10);
+  /* USER CODE END EXTI15_10_IRQn 1 */
+}
+
 /* USER CODE BEGIN 1 */
+/**
+  * @brief This function handles DMA1 channel4 global interrupt (telemetry USART1 TX).
+  */
+void DMA1_Channel4_IRQHandler(void)
+{
+  PROF_ENTER(PROF_DMA1_CH4);
+  TLM_IRQHandler();
+  PROF_EXIT(PROF_DMA1_CH4);
+}
+
+/**
+  * @brief This function handles ADC1 and ADC2 global interrupts (NTC sample complete).
+  */
+void ADC1_2_IRQHandler(void)
+{
+  PROF_ENTER(PROF_ADC);
+  HAL_ADC_IRQHandler(&hadc2);
+  PROF_EXIT(PROF_ADC);
+}
 
 /* USER CODE END 1 */
@@ -0,0 +1,262 @@
+#include "swtimer.h"
+#include "irq.h"
+
+#define L0_SIZE (1u << SWT_L0_BITS)
+#define LN_SIZE (1u << SWT_LN_BITS)
+#define L0_MASK (L0_SIZE - 1u)
+#define LN_MASK (LN_SIZE - 1u)
+
+enum {
+    SWT_IDLE = 0,
+    SWT_ARMED,      // 在时间轮的某个槽中
+    SWT_EXPIRED     // 在到期链表中，等待 SWT_Process
+};
+
+static SWT_Node wheel0[L0_SIZE];
+static SWT_Node wheel1[LN_SIZE];
+static SWT_Node wheel2[LN_SIZE];
+static SWT_Node expired;
+static volatile uint32_t now_tick = 0;
+static uint8_t wheel_ready = 0;        // SysTick 在 SWT_Init 之前已经运行
+static volatile uint32_t revision = 0;
+
+// 时间轮由 SysTick 与线程上下文共同修改，只需屏蔽到 SysTick 一级
+static inline uint32_t SWT_Lock(void)
+{
+    return IRQ_Lock(IRQ_PRIO_SYSTICK);
+}
+
+static inline void SWT_Unlock(uint32_t prev)
+{
+    IRQ_Unlock(prev);
+}
+
+static inline void list_init(SWT_Node *head)
+{
+    head->next = head;
+    head->prev = head;
+}
+
+static inline uint8_t list_empty(const SWT_Node *head)
+{
+    return head->next == head;
+}
+
+static inline void list_unlink(SWT_Node *node)
+{
+    node->prev->next = node->next;
+    node->next->prev = node->prev;
+}
+
+static inline void list_append(SWT_Node *head, SWT_Node *node)
+{
+    node->prev = head->prev;
+    node->next = head;
+    head->prev->next = node;
+    head->prev = node;
+}
+
+// 把 src 整条链表接到 dst 末尾，src 清空
+static inline void list_splice(SWT_Node *dst, SWT_Node *src)
+{
+    if (list_empty(src)) {
+        return;
+    }
+    src->next->prev = dst->prev;
+    dst->prev->next = src->next;
+    src->prev->next = dst;
+    dst->prev = src->prev;
+    list_init(src);
+}
+
+// 按剩余时间放入对应层的槽（调用方已加锁）
+static void SWT_Insert(SWT_Timer *timer)
+{
+    uint32_t expires = timer->expires;
+    uint32_t delta = expires - now_tick;
+    SWT_Node *slot;
+
+    if (delta < L0_SIZE) {
+        slot = &wheel0[expires & L0_MASK];
+    } else if (delta < (1ul << (SWT_L0_BITS + SWT_LN_BITS))) {
+        slot = &wheel1[(expires >> SWT_L0_BITS) & LN_MASK];
+    } else {
+        if (delta >= SWT_MAX_SPAN) {
+            expires = now_tick + SWT_MAX_SPAN - 1u;   // 暂放最远的槽，级联时按真实到期时刻重排
+        }
+        slot = &wheel2[(expires >> (SWT_L0_BITS + SWT_LN_BITS)) & LN_MASK];
+    }
+    list_append(slot, &timer->node);
+    timer->state = SWT_ARMED;
+}
+
+// 把高层一个槽中的定时器重新分配到低层
+static void SWT_Cascade(SWT_Node *slot)
+{
+    SWT_Node pending;
+
+    list_init(&pending);
+    list_splice(&pending, slot);
+    while (!list_empty(&pending)) {
+        SWT_Node *node = pending.next;
+        list_unlink(node);
+        SWT_Insert((SWT_Timer *)node);
+    }
+}
+
+void SWT_Init(void)
+{
+    for (uint32_t i = 0; i < L0_SIZE; i++) {
+        list_init(&wheel0[i]);
+    }
+    for (uint32_t i = 0; i < LN_SIZE; i++) {
+        list_init(&wheel1[i]);
+        list_init(&wheel2[i]);
+    }
+    list_init(&expired);
+    now_tick = 0;
+    wheel_ready = 1;
+}
+
+void SWT_Start(SWT_Timer *timer, uint32_t delay_ms, uint32_t period_ms,
+               SWT_Callback callback, void *arg)
+{
+    uint32_t prev = SWT_Lock();
+
+    if (timer->state != SWT_IDLE) {
+        list_unlink(&timer->node);
+    }
+    timer->callback = callback;
+    timer->arg = arg;
+    timer->period = period_ms;
+    timer->expires = now_tick + (delay_ms ? delay_ms : 1u);
+    SWT_Insert(timer);
+    revision++;
+
+    SWT_Unlock(prev);
+}
+
+void SWT_Stop(SWT_Timer *timer)
+{
+    uint32_t prev = SWT_Lock();
+
+    if (timer->state != SWT_IDLE) {
+        list_unlink(&timer->node);
+        timer->state = SWT_IDLE;
+    }
+
+    SWT_Unlock(prev);
+}
+
+uint8_t SWT_IsActive(const SWT_Timer *timer)
+{
+    return timer->state != SWT_IDLE;
+}
+
+uint32_t SWT_Now(void)
+{
+    return now_tick;
+}
+
+void SWT_Tick(void)
+{
+    if (!wheel_ready) {
+        return;
+    }
+
+    uint32_t now = now_tick + 1u;
+    uint32_t index = now & L0_MASK;
+    uint8_t was_empty = list_empty(&expired);
+
+    now_tick = now;
+    if (index == 0) {
+        uint32_t index1 = (now >> SWT_L0_BITS) & LN_MASK;
+        if (index1 == 0) {
+            SWT_Cascade(&wheel2[(now >> (SWT_L0_BITS + SWT_LN_BITS)) & LN_MASK]);
+        }
+        SWT_Cascade(&wheel1[index1]);
+    }
+
+    SWT_Node *slot = &wheel0[index];
+    if (list_empty(slot)) {
+        return;
+    }
+    for (SWT_Node *node = slot->next; node != slot; node = node->next) {
+        ((SWT_Timer *)node)->state = SWT_EXPIRED;
+    }
+    list_splice(&expired, slot);
+    if (was_empty) {
+        SWT_ExpiredCallback();
+    }
+}
+
+void SWT_Advance(uint32_t ticks)
+{
+    while (ticks--) {
+        SWT_Tick();
+    }
+}
+
+uint32_t SWT_NextExpiry(void)
+{
+    uint32_t prev = SWT_Lock();
+    uint32_t now = now_tick;
+    uint32_t ticks = L0_SIZE;
+
+    if (!list_empty(&expired)) {
+        ticks = 0;
+    }
+    for (uint32_t i = 1; ticks == L0_SIZE && i < L0_SIZE; i++) {
+        uint32_t t = now + i;
+        if ((t & L0_MASK) == 0) {
+            uint32_t index1 = (t >> SWT_L0_BITS) & LN_MASK;
+            if (!list_empty(&wheel1[index1])
+                || (index1 == 0 && !list_empty(&wheel2[(t >> (SWT_L0_BITS + SWT_LN_BITS)) & LN_MASK]))) {
+                ticks = i;
+                break;
+            }
+        }
+        if (!list_empty(&wheel0[t & L0_MASK])) {
+            ticks = i;
+        }
+    }
+
+    SWT_Unlock(prev);
+    return ticks;
+}
+
+uint32_t SWT_Revision(void)
+{
+    return revision;
+}
+
+void SWT_Process(void)
+{
+    while (1) {
+        uint32_t prev = SWT_Lock();
+        SWT_Node *node = expired.next;
+        if (node == &expired) {
+            SWT_Unlock(prev);
+            return;
+        }
+        SWT_Timer *timer = (SWT_Timer *)node;
+        list_unlink(node);
+        timer->state = SWT_IDLE;
+        if (timer->period) {
+            // 保持相位；处理延迟超过一个周期时从下一个 tick 重新开始
+            timer->expires += timer->period;
+            if ((int32_t)(timer->expires - now_tick) <= 0) {
+                timer->expires = now_tick + 1u;
+            }
+            SWT_Insert(timer);
+        }
+        SWT_Unlock(prev);
+
+        // 回调在锁外执行，可在其中 SWT_Start/SWT_Stop 自己或其他定时器
+        timer->callback(timer, timer->arg);
+    }
+}
+
+__weak void SWT_ExpiredCallback(void)
+{
+}
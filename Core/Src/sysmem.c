@@ -23,12 +23,85 @@
 /* Includes */
 #include <errno.h>
 #include <stdint.h>
+#include "heap.h"
+#include "log.h"
+#include "metrics.h"
+#include "telemetry.h"
 
 /**
  * Pointer to the current high watermark of the heap usage
  */
 static uint8_t *__sbrk_heap_end = NULL;
 
+/* Heap accounting, see heap.h; the HEAP_Stats fields live in the metrics block */
+METRIC_COUNTER(heap_calls);
+METRIC_COUNTER(heap_failures);
+METRIC_COUNTER(heap_sealed_calls);
+METRIC_GAUGE(heap_brk);
+METRIC_GAUGE(heap_brk_peak);
+static HEAP_Trace heap_trace[HEAP_TRACE_DEPTH];
+static uint8_t heap_sealed = 0;
+static uint32_t heap_reported = UINT32_MAX;
+
+/* Collect words on the stack that look like Thumb return addresses into .text */
+static void heap_backtrace(HEAP_Trace *trace)
+{
+  extern uint8_t g_pfnVectors; /* Start of flash, defined in the startup file */
+  extern uint8_t _etext; /* Symbol defined in the linker script */
+  extern uint8_t _estack; /* Symbol defined in the linker script */
+  const uint32_t *sp = (const uint32_t *)__get_MSP();
+  const uint32_t *top = (const uint32_t *)&_estack;
+  uint32_t found = 0;
+
+  for (uint32_t i = 0; i < 64u && sp < top && found < HEAP_CALLER_DEPTH; i++, sp++)
+  {
+    uint32_t word = *sp;
+    if ((word & 1u) && word > (uint32_t)&g_pfnVectors && word < (uint32_t)&_etext)
+    {
+      trace->callers[found++] = word & ~1u;
+    }
+  }
+  while (found < HEAP_CALLER_DEPTH)
+  {
+    trace->callers[found++] = 0;
+  }
+}
+
+#if HEAP_STRICT
+/* Undefined instruction with the arguments still in r0-r3 (naked: no prologue touches them).
+   The UsageFault handler's CRASH_CAPTURE (crash.h) keeps the stacked r0-r3 across the reset
+   and CRASH_Report logs them on the next boot */
+__attribute__((naked, noreturn))
+static void heap_trap(uint32_t incr, uint32_t caller0, uint32_t caller1, uint32_t caller2)
+{
+  __asm volatile ("udf #0");
+}
+#endif
+
+static void heap_record(ptrdiff_t incr)
+{
+  const uint32_t calls = metric_heap_calls;
+
+  if (calls < HEAP_TRACE_DEPTH)
+  {
+    heap_trace[calls].incr = (int32_t)incr;
+    heap_backtrace(&heap_trace[calls]);
+  }
+  METRIC_INC(heap_calls);
+  if (heap_sealed)
+  {
+    METRIC_INC(heap_sealed_calls);
+#if HEAP_STRICT
+    /* The trace slots may be used up by the start-up calls, take this caller separately */
+    HEAP_Trace trace;
+    heap_backtrace(&trace);
+    LOG_ERROR("heap: _sbrk(%d) after seal, callers %#010x %#010x %#010x",
+              (uint32_t)incr, trace.callers[0], trace.callers[1], trace.callers[2]);
+    heap_trap((uint32_t)incr, trace.callers[0], trace.callers[1], trace.callers[2]);
+#endif
+  }
+}
+
 /**
  * @brief _sbrk() allocates memory to the newlib heap and is used by malloc
  *        and others from the C library
@@ -59,6 +132,8 @@ void *_sbrk(ptrdiff_t incr)
   const uint8_t *max_heap = (uint8_t *)stack_limit;
   uint8_t *prev_heap_end;
 
+  heap_record(incr);
+
   /* Initialize heap end at first call */
   if (NULL == __sbrk_heap_end)
   {
@@ -68,6 +143,7 @@ void *_sbrk(ptrdiff_t incr)
   /* Protect heap from growing into the reserved MSP stack */
   if (__sbrk_heap_end + incr > max_heap)
   {
+    METRIC_INC(heap_failures);
     errno = ENOMEM;
     return (void *)-1;
   }
@@ -75,5 +151,56 @@ void *_sbrk(ptrdiff_t incr)
   prev_heap_end = __sbrk_heap_end;
   __sbrk_heap_end += incr;
 
+  METRIC_SET(heap_brk, __sbrk_heap_end - &_end);
+  if (metric_heap_brk > metric_heap_brk_peak)
+  {
+    METRIC_SET(heap_brk_peak, metric_heap_brk);
+  }
+
   return (void *)prev_heap_end;
 }
+
+void HEAP_Seal(void)
+{
+  heap_sealed = 1;
+}
+
+void HEAP_GetStats(HEAP_Stats *out)
+{
+  out->calls = metric_heap_calls;
+  out->failures = metric_heap_failures;
+  out->sealed_calls = metric_heap_sealed_calls;
+  out->brk = (uint32_t)metric_heap_brk;
+  out->brk_peak = (uint32_t)metric_heap_brk_peak;
+}
+
+const HEAP_Trace *HEAP_GetTrace(uint32_t index)
+{
+  if (index >= metric_heap_calls || index >= HEAP_TRACE_DEPTH)
+  {
+    return NULL;
+  }
+  return &heap_trace[index];
+}
+
+void HEAP_Dump(void)
+{
+  static HEAP_Report report;
+  HEAP_Stats stats;
+
+  HEAP_GetStats(&stats);
+  if (stats.calls == heap_reported)
+  {
+    return;
+  }
+  report.stats = stats;
+  report.traces = (uint8_t)(stats.calls < HEAP_TRACE_DEPTH ? stats.calls : HEAP_TRACE_DEPTH);
+  for (uint32_t i = 0; i < HEAP_TRACE_DEPTH; i++)
+  {
+    report.trace[i] = heap_trace[i];
+  }
+  if (TLM_Send(TLM_CH_HEAP, &report, sizeof(report)) == HAL_OK)
+  {
+    heap_reported = stats.calls;
+  }
+}
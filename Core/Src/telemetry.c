@@ -0,0 +1,152 @@
+#include "telemetry.h"
+#include "irq.h"
+#include "metrics.h"
+#include "trace.h"
+
+#if (TLM_TX_SIZE & (TLM_TX_SIZE - 1)) != 0
+#error "TLM_TX_SIZE 须为 2 的幂"
+#endif
+
+// 最长的编码帧：通道号 + 数据 + CRC，COBS 开销 1 字节（254 字节以内），加结尾 0
+#define FRAME_MAX (1u + TLM_MAX_PAYLOAD + 2u + 1u + 1u)
+
+// 单生产者（线程）单消费者（DMA 完成中断）：head 只由 TLM_Send 写，tail 只由中断写
+static uint8_t tx_buf[TLM_TX_SIZE];
+static volatile uint16_t tx_head = 0;
+static volatile uint16_t tx_tail = 0;
+static volatile uint16_t tx_busy = 0;   // DMA 正在发送的字节数，0 为空闲
+static uint8_t tlm_ready = 0;
+static uint8_t raw[1u + TLM_MAX_PAYLOAD + 2u];  // 编码前后的帧，只在 TLM_Send（线程上下文）中使用
+static uint8_t frame[FRAME_MAX];
+
+METRIC_COUNTER(tlm_frames);
+METRIC_COUNTER(tlm_dropped);
+METRIC_COUNTER(tlm_bytes);
+
+static uint16_t TLM_Crc16(uint16_t crc, const uint8_t *data, uint16_t len)
+{
+    while (len--) {
+        crc ^= (uint16_t)(*data++ << 8);
+        for (uint8_t i = 0; i < 8; i++) {
+            crc = (crc & 0x8000u) ? (uint16_t)((crc << 1) ^ 0x1021u) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+// 对 src 做 COBS 编码并追加结尾 0，返回编码后长度；src 不超过 254 字节
+static uint16_t TLM_Cobs(uint8_t *dst, const uint8_t *src, uint16_t len)
+{
+    uint16_t code_pos = 0;
+    uint16_t out = 1;
+    uint8_t code = 1;
+
+    for (uint16_t i = 0; i < len; i++) {
+        if (src[i] == 0) {
+            dst[code_pos] = code;
+            code_pos = out++;
+            code = 1;
+        } else {
+            dst[out++] = src[i];
+            code++;
+        }
+    }
+    dst[code_pos] = code;
+    dst[out++] = 0;
+    return out;
+}
+
+// DMA 空闲且有数据时发送一段连续数据，调用方已屏蔽 DMA 中断
+static void TLM_Kick(void)
+{
+    uint16_t tail = tx_tail;
+    uint16_t used = (uint16_t)(tx_head - tail);
+
+    if (tx_busy != 0 || used == 0) {
+        return;
+    }
+    uint16_t offset = tail & (TLM_TX_SIZE - 1u);
+    uint16_t len = (used < TLM_TX_SIZE - offset) ? used : (uint16_t)(TLM_TX_SIZE - offset);
+
+    tx_busy = len;
+    DMA1_Channel4->CCR &= ~DMA_CCR_EN;
+    DMA1_Channel4->CMAR = (uint32_t)&tx_buf[offset];
+    DMA1_Channel4->CNDTR = len;
+    DMA1_Channel4->CCR |= DMA_CCR_EN;
+}
+
+HAL_StatusTypeDef TLM_Init(void)
+{
+    GPIO_InitTypeDef GPIO_InitStruct = {0};
+
+    __HAL_RCC_GPIOA_CLK_ENABLE();
+    __HAL_RCC_USART1_CLK_ENABLE();
+    __HAL_RCC_DMA1_CLK_ENABLE();
+
+    GPIO_InitStruct.Pin = GPIO_PIN_9;
+    GPIO_InitStruct.Mode = GPIO_MODE_AF_PP;
+    GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_HIGH;
+    HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
+
+    USART1->CR1 = 0;
+    USART1->BRR = (HAL_RCC_GetPCLK2Freq() + TLM_BAUD / 2u) / TLM_BAUD;
+    USART1->CR2 = 0;
+    USART1->CR3 = USART_CR3_DMAT;
+    USART1->CR1 = USART_CR1_UE | USART_CR1_TE;
+
+    // 8 位传输，存储器递增，存储器 → 外设，传输完成中断
+    DMA1_Channel4->CCR = 0;
+    DMA1_Channel4->CPAR = (uint32_t)&USART1->DR;
+    DMA1_Channel4->CCR = DMA_CCR_MINC | DMA_CCR_DIR | DMA_CCR_TCIE;
+    DMA1->IFCR = DMA_IFCR_CGIF4;
+    HAL_NVIC_EnableIRQ(DMA1_Channel4_IRQn);
+
+    tx_head = 0;
+    tx_tail = 0;
+    tx_busy = 0;
+    tlm_ready = 1;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef TLM_Send(TLM_Channel channel, const void *data, uint16_t len)
+{
+    if (!tlm_ready || len > TLM_MAX_PAYLOAD) {
+        return HAL_ERROR;
+    }
+    raw[0] = (uint8_t)channel;
+    for (uint16_t i = 0; i < len; i++) {
+        raw[1u + i] = ((const uint8_t *)data)[i];
+    }
+    uint16_t crc = TLM_Crc16(0xFFFFu, raw, (uint16_t)(1u + len));
+    raw[1u + len] = (uint8_t)crc;
+    raw[2u + len] = (uint8_t)(crc >> 8);
+    uint16_t n = TLM_Cobs(frame, raw, (uint16_t)(3u + len));
+
+    uint16_t head = tx_head;
+    if ((uint16_t)(TLM_TX_SIZE - (uint16_t)(head - tx_tail)) < n) {
+        METRIC_INC(tlm_dropped);
+        TRACE_Event(TRACE_OVERFLOW, TRACE_Q_TLM, (uint16_t)metric_tlm_dropped);
+        return HAL_BUSY;
+    }
+    for (uint16_t i = 0; i < n; i++) {
+        tx_buf[(uint16_t)(head + i) & (TLM_TX_SIZE - 1u)] = frame[i];
+    }
+    tx_head = (uint16_t)(head + n);
+    METRIC_INC(tlm_frames);
+    METRIC_ADD(tlm_bytes, n);
+
+    uint32_t prev = IRQ_Lock(IRQ_PRIO_USART);
+    TLM_Kick();
+    IRQ_Unlock(prev);
+    return HAL_OK;
+}
+
+void TLM_IRQHandler(void)
+{
+    if (DMA1->ISR & DMA_ISR_TCIF4) {
+        DMA1->IFCR = DMA_IFCR_CGIF4;
+        tx_tail = (uint16_t)(tx_tail + tx_busy);
+        tx_busy = 0;
+        TLM_Kick();
+    }
+}
@@ -0,0 +1,120 @@
+#include "tickless.h"
+#include "cpuload.h"
+#include "irq.h"
+#include "key.h"
+#include "metrics.h"
+#include "scheduler.h"
+#include "swtimer.h"
+
+#define SYSTICK_MAX_LOAD 0xFFFFFFu
+
+// 休眠期间供 HAL_GetTick 推算当前 tick
+static volatile uint8_t sleeping = 0;
+static uint32_t sleep_ticks;        // 本次计划休眠的 tick 数
+static uint32_t tick_counts;        // 每 tick 的 SysTick 计数
+
+METRIC_COUNTER(tickless_sleeps);
+METRIC_COUNTER(tickless_early);
+METRIC_COUNTER(tickless_wakeups);
+METRIC_COUNTER(tickless_ticks_skipped);
+
+// 从休眠开始时所在 tick 的起点算起，SysTick 已走过的计数
+static uint32_t TICKLESS_Elapsed(uint32_t load)
+{
+    uint32_t val = SysTick->VAL;
+    if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) {
+        // 已到期并重装载：到期后又走过 load - val 个计数
+        return sleep_ticks * tick_counts + (load - val);
+    }
+    return sleep_ticks * tick_counts - val;
+}
+
+/**
+ * 覆盖 HAL 的弱定义：休眠期间 uwTick 停止递增，改为按 SysTick 已走过的计数推算
+ */
+uint32_t HAL_GetTick(void)
+{
+    if (!sleeping) {
+        return uwTick;
+    }
+    uint32_t val = SysTick->VAL;
+    if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) {
+        return uwTick + sleep_ticks;
+    }
+    return uwTick + (sleep_ticks * tick_counts - val) / tick_counts;
+}
+
+void TICKLESS_Idle(uint32_t idle_ms)
+{
+    uint32_t next = SWT_NextExpiry();
+    if (next < idle_ms) {
+        idle_ms = next;
+    }
+    if (idle_ms < TICKLESS_MIN_MS || !KEY_IsIdle()) {
+        LOAD_Wfi();
+        return;
+    }
+
+    tick_counts = SysTick->LOAD + 1u;
+    uint32_t max_ticks = SYSTICK_MAX_LOAD / tick_counts;
+    if (idle_ms > max_ticks) {
+        idle_ms = max_ticks;
+    }
+
+    // 停止 SysTick，把当前 tick 剩余的计数加上其后 idle_ms - 1 个 tick 作为一次重装载
+    SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+    if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) {
+        SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;   // 停止前刚好到期，交给 SysTick 中断处理
+        return;
+    }
+    uint32_t load = SysTick->VAL + tick_counts * (idle_ms - 1u);
+    uint32_t revision = SWT_Revision();
+
+    sleep_ticks = idle_ms;
+    sleeping = 1;
+    SysTick->LOAD = load - 1u;
+    SysTick->VAL = 0;
+    SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+    METRIC_INC(tickless_sleeps);
+
+    while (1) {
+        LOAD_Wfi();
+        if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) {
+            break;      // 休眠时间到
+        }
+        // 只放行抢占优先级高于 SysTick 的中断，SysTick 自身在补计前不能运行
+        __set_BASEPRI(IRQ_BASEPRI(IRQ_PRIO_SYSTICK));
+        __enable_irq();
+        __ISB();
+        __disable_irq();
+        __set_BASEPRI(0);
+        if ((SCB->ICSR & SCB_ICSR_VECTPENDING_Msk) || SCHED_Pending() || !KEY_IsIdle()
+            || SWT_Revision() != revision) {
+            METRIC_INC(tickless_early);
+            break;
+        }
+        METRIC_INC(tickless_wakeups);
+    }
+
+    // 停表补计：已走完的 tick 直接计入，当前 tick 剩余的计数作为下一次重装载
+    SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+    uint32_t elapsed = TICKLESS_Elapsed(load - 1u);
+    uint32_t ticks = elapsed / tick_counts;
+    uint32_t remain = tick_counts - elapsed % tick_counts;
+    if (remain < 2u) {
+        // 重装载值为 0 时 SysTick 不产生中断，紧挨着的这个 tick 也直接计入
+        ticks++;
+        remain += tick_counts;
+    }
+
+    SCB->ICSR = SCB_ICSR_PENDSTCLR_Msk;     // 到期的那一个 tick 也在这里补计
+    uwTick += ticks;
+    sleeping = 0;
+    SWT_Advance(ticks);
+    METRIC_ADD(tickless_ticks_skipped, ticks);
+
+    SysTick->LOAD = remain - 1u;
+    SysTick->VAL = 0;
+    SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+    SysTick->LOAD = tick_counts - 1u;
+}
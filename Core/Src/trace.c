@@ -0,0 +1,126 @@
+#include "trace.h"
+#include "scheduler.h"
+#include "telemetry.h"
+#include "mono.h"
+
+#if (TRACE_DEPTH & (TRACE_DEPTH - 1)) != 0
+#error "TRACE_DEPTH 须为 2 的幂"
+#endif
+
+#if TRACE_ENABLE
+
+#define TRACE_CHUNK ((TLM_MAX_PAYLOAD - sizeof(TRACE_DumpChunk)) / sizeof(TRACE_Entry))
+
+TRACE_Entry trace_ring[TRACE_DEPTH] __attribute__((section(".noinit")));   // 复位不清零，见 crash.h
+volatile uint32_t trace_head = 0;
+volatile uint8_t trace_frozen = 0;
+
+// 转储进度：dump_pos 为 0 表示尚未发头帧，之后为已发事件数 + 1
+static uint32_t dump_sequence = 0;
+static uint32_t dump_pos = 0;
+static uint32_t dump_first;             // 最旧事件的序号
+static uint16_t dump_count;
+
+void TRACE_Freeze(void)
+{
+    trace_frozen = 1;
+}
+
+void TRACE_Resume(void)
+{
+    dump_pos = 0;
+    trace_head = 0;
+    trace_frozen = 0;
+}
+
+void TRACE_Restore(uint32_t head)
+{
+    trace_head = head;
+    trace_frozen = 1;
+}
+
+static HAL_StatusTypeDef TRACE_SendHeader(void)
+{
+    static uint8_t buf[sizeof(TRACE_DumpHeader) + SCHED_MAX_TASKS * TRACE_NAME_LEN];
+    TRACE_DumpHeader *header = (TRACE_DumpHeader *)buf;
+    uint8_t tasks = 0;
+
+    for (const SCHED_Task *task; tasks < SCHED_MAX_TASKS && (task = SCHED_GetTask(tasks)) != NULL; tasks++) {
+        char *name = (char *)&buf[sizeof(TRACE_DumpHeader) + tasks * TRACE_NAME_LEN];
+        uint8_t i = 0;
+        for (; i < TRACE_NAME_LEN && task->name != NULL && task->name[i] != '\0'; i++) {
+            name[i] = task->name[i];
+        }
+        for (; i < TRACE_NAME_LEN; i++) {
+            name[i] = '\0';
+        }
+    }
+    header->kind = TRACE_KIND_HEADER;
+    header->tasks = tasks;
+    header->count = dump_count;
+    header->sequence = dump_sequence;
+    header->cpu_hz = MONO_CPU_HZ;
+    return TLM_Send(TLM_CH_TRACE, buf, (uint16_t)(sizeof(TRACE_DumpHeader) + tasks * TRACE_NAME_LEN));
+}
+
+HAL_StatusTypeDef TRACE_Dump(void)
+{
+    static struct __attribute__((packed)) {
+        TRACE_DumpChunk chunk;
+        TRACE_Entry entries[TRACE_CHUNK];
+    } frame;
+
+    if (dump_pos == 0) {
+        trace_frozen = 1;
+        uint32_t head = trace_head;
+        dump_count = (uint16_t)(head < TRACE_DEPTH ? head : TRACE_DEPTH);
+        dump_first = head - dump_count;
+        dump_sequence++;
+        if (TRACE_SendHeader() != HAL_OK) {
+            return HAL_BUSY;
+        }
+        dump_pos = 1;
+    }
+    while (dump_pos - 1u < dump_count) {
+        uint32_t index = dump_pos - 1u;
+        uint32_t n = dump_count - index;
+        if (n > TRACE_CHUNK) {
+            n = TRACE_CHUNK;
+        }
+        frame.chunk.kind = TRACE_KIND_EVENTS;
+        frame.chunk.reserved = 0;
+        frame.chunk.index = (uint16_t)index;
+        frame.chunk.sequence = dump_sequence;
+        for (uint32_t i = 0; i < n; i++) {
+            frame.entries[i] = trace_ring[(dump_first + index + i) & (TRACE_DEPTH - 1u)];
+        }
+        if (TLM_Send(TLM_CH_TRACE, &frame, (uint16_t)(sizeof(TRACE_DumpChunk) + n * sizeof(TRACE_Entry))) != HAL_OK) {
+            return HAL_BUSY;
+        }
+        dump_pos += n;
+    }
+    dump_pos = 0;
+    return HAL_OK;
+}
+
+#else
+
+void TRACE_Freeze(void)
+{
+}
+
+void TRACE_Resume(void)
+{
+}
+
+void TRACE_Restore(uint32_t head)
+{
+    (void)head;
+}
+
+HAL_StatusTypeDef TRACE_Dump(void)
+{
+    return HAL_ERROR;
+}
+
+#endif // TRACE_ENABLE
@@ -94,6 +94,21 @@ LoopFillZerobss:
   cmp r2, r4
   bcc FillZerobss
 
+/* Paint the free RAM from _ebss up to the current SP with STACK_PAINT (stack.h)
+   so that STACK_GetStats can find the stack high-watermark. */
+  ldr r2, =_ebss
+  mov r4, sp
+  ldr r3, =0xA5A5A5A5
+  b LoopPaintStack
+
+PaintStack:
+  str r3, [r2]
+  adds r2, r2, #4
+
+LoopPaintStack:
+  cmp r2, r4
+  bcc PaintStack
+
 /* Call static constructors */
     bl __libc_init_array
 /* Call the application's entry point.*/
@@ -0,0 +1,174 @@
+/**
+ * @file  tlmhost.h
+ * @brief 遥测主机工具的公共部分：读取 ELF 段、切分并校验遥测帧（见 Core/Inc/telemetry.h）
+ *
+ * 只有头文件，各工具单文件编译时加 -ITools/common。
+ */
+#ifndef __TLMHOST_H
+#define __TLMHOST_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// 与 Core/Inc/telemetry.h 的 TLM_Channel 一致
+#define TLM_HOST_CH_TEXT    0u
+#define TLM_HOST_CH_LOG     7u
+#define TLM_HOST_CH_METRICS 8u
+#define TLM_HOST_CH_TRACE   9u
+
+#define TLM_HOST_FRAME_MAX 512u
+
+typedef struct {
+    const uint8_t *data;
+    uint64_t addr;          // 段地址，不装载的段在固件中为 0
+    uint64_t size;
+} TlmSection;
+
+typedef struct {
+    uint8_t *image;
+    uint64_t size;
+} TlmElf;
+
+static inline uint64_t tlm_get_le(const uint8_t *p, unsigned n)
+{
+    uint64_t v = 0;
+    for (unsigned i = 0; i < n; i++) {
+        v |= (uint64_t)p[i] << (8u * i);
+    }
+    return v;
+}
+
+// 读入整个小端 ELF32/ELF64 文件
+static inline int tlm_elf_open(const char *path, TlmElf *elf)
+{
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) {
+        perror(path);
+        return -1;
+    }
+    fseek(f, 0, SEEK_END);
+    long len = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    uint8_t *image = len > 0 ? malloc((size_t)len) : NULL;
+    if (image == NULL || fread(image, 1, (size_t)len, f) != (size_t)len) {
+        fclose(f);
+        free(image);
+        fprintf(stderr, "%s: read failed\n", path);
+        return -1;
+    }
+    fclose(f);
+    if (len < 52 || memcmp(image, "\177ELF", 4) != 0 || image[5] != 1) {
+        free(image);
+        fprintf(stderr, "%s: not a little-endian ELF file\n", path);
+        return -1;
+    }
+    elf->image = image;
+    elf->size = (uint64_t)len;
+    return 0;
+}
+
+// 查找名为 name 的段，找不到返回 -1
+static inline int tlm_elf_section(const TlmElf *elf, const char *name, TlmSection *out)
+{
+    const uint8_t *img = elf->image;
+    const int is64 = (img[4] == 2);
+    const uint64_t shoff = is64 ? tlm_get_le(img + 0x28, 8) : tlm_get_le(img + 0x20, 4);
+    const unsigned shentsize = (unsigned)tlm_get_le(img + (is64 ? 0x3A : 0x2E), 2);
+    const unsigned shnum = (unsigned)tlm_get_le(img + (is64 ? 0x3C : 0x30), 2);
+    const unsigned shstrndx = (unsigned)tlm_get_le(img + (is64 ? 0x3E : 0x32), 2);
+    if (shoff + (uint64_t)shnum * shentsize > elf->size || shstrndx >= shnum) {
+        return -1;
+    }
+
+    // 段头中名称、地址、文件偏移、大小
+    #define TLM_SH(i)       (img + shoff + (uint64_t)(i) * shentsize)
+    #define TLM_SH_ADDR(sh) (is64 ? tlm_get_le((sh) + 0x10, 8) : tlm_get_le((sh) + 0x0C, 4))
+    #define TLM_SH_OFF(sh)  (is64 ? tlm_get_le((sh) + 0x18, 8) : tlm_get_le((sh) + 0x10, 4))
+    #define TLM_SH_SIZE(sh) (is64 ? tlm_get_le((sh) + 0x20, 8) : tlm_get_le((sh) + 0x14, 4))
+    const uint8_t *strtab = img + TLM_SH_OFF(TLM_SH(shstrndx));
+    int found = -1;
+    for (unsigned i = 0; i < shnum; i++) {
+        const uint8_t *sh = TLM_SH(i);
+        if (strcmp((const char *)strtab + tlm_get_le(sh, 4), name) == 0
+            && TLM_SH_OFF(sh) + TLM_SH_SIZE(sh) <= elf->size) {
+            out->addr = TLM_SH_ADDR(sh);
+            out->size = TLM_SH_SIZE(sh);
+            out->data = img + TLM_SH_OFF(sh);
+            found = 0;
+            break;
+        }
+    }
+    #undef TLM_SH
+    #undef TLM_SH_ADDR
+    #undef TLM_SH_OFF
+    #undef TLM_SH_SIZE
+    return found;
+}
+
+static inline uint16_t tlm_crc16(const uint8_t *data, size_t len)
+{
+    uint16_t crc = 0xFFFFu;
+    while (len--) {
+        crc ^= (uint16_t)(*data++ << 8);
+        for (int i = 0; i < 8; i++) {
+            crc = (crc & 0x8000u) ? (uint16_t)((crc << 1) ^ 0x1021u) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+// COBS 解码（不含结尾 0），返回解码后长度，格式错误返回 -1
+static inline int tlm_cobs_decode(uint8_t *dst, const uint8_t *src, size_t len)
+{
+    size_t in = 0;
+    size_t out = 0;
+    while (in < len) {
+        uint8_t code = src[in++];
+        if (code == 0 || in + code - 1u > len) {
+            return -1;
+        }
+        for (uint8_t i = 1; i < code; i++) {
+            dst[out++] = src[in++];
+        }
+        if (code != 0xFF && in < len) {
+            dst[out++] = 0;
+        }
+    }
+    return (int)out;
+}
+
+/**
+ * 读取下一个有效帧到 raw（raw[0] 为通道号，其后为数据，CRC 已去掉），
+ * 返回数据长度（不含通道号）；流结束返回 -1。COBS 或 CRC 错误的帧计入 *bad 并跳过。
+ */
+static inline int tlm_read_frame(FILE *in, uint8_t raw[TLM_HOST_FRAME_MAX], unsigned long *bad)
+{
+    uint8_t buf[TLM_HOST_FRAME_MAX];
+    size_t len = 0;
+    int c;
+
+    while ((c = fgetc(in)) != EOF) {
+        if (c != 0) {
+            if (len < sizeof(buf)) {
+                buf[len] = (uint8_t)c;
+            }
+            len++;
+            continue;
+        }
+        if (len == 0) {
+            continue;
+        }
+        int n = len <= sizeof(buf) ? tlm_cobs_decode(raw, buf, len) : -1;
+        len = 0;
+        if (n < 3 || tlm_crc16(raw, (size_t)n - 2u) != (uint16_t)tlm_get_le(raw + n - 2, 2)) {
+            (*bad)++;
+            continue;
+        }
+        return n - 3;
+    }
+    return -1;
+}
+
+#endif // __TLMHOST_H
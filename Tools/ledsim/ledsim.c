@@ -0,0 +1,312 @@
+/**
+ * @file  ledsim.c
+ * @brief LED 刷新引擎的主机仿真
+ *
+ * 直接链接 Core/Src/led.c，用 shim/ 中的 HAL 替身代替真实寄存器：
+ * 每次模拟 TIM2 更新事件调用 LED_UpdateDisplay()，读取它写入假 GPIOB->BSRR 的值，
+ * 按时间戳记录 ODR 变化，并积分出每个 LED 的点亮占空比。
+ *
+ * 编译（仓库根目录）：
+ *   cc -std=c11 -O2 -ITools/ledsim/shim -ICore/Inc -o ledsim Tools/ledsim/ledsim.c Core/Src/led.c
+ *
+ * 用法：ledsim [-f 帧数] [-b 亮度] [-v 行0,行1,...] [-l 中断延迟ns] [-j 延迟抖动ns]
+ *              [-g 行驱动关断延迟ns] [-p 输出.ppm] [-r 记录.csv] [-c]
+ *   -v  vram 各行的十六进制值，默认 5b,cf,6d,40,40,40（"23.4---"）
+ *   -g  模拟行驱动管关断拖尾，用于观察重影
+ *   -c  检查模式：帧率 < 100Hz、重影能量 > 1% 或占空比误差 > 2% 时返回 1
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "led.h"
+
+#define TICK_NS 10000u      // TIM2 计数周期：72MHz / 720
+
+GPIO_TypeDef sim_gpioa;
+GPIO_TypeDef sim_gpiob;
+GPIO_TypeDef sim_gpioc;
+TIM_TypeDef sim_tim2;
+
+typedef struct {
+    uint64_t t_ns;
+    uint32_t bsrr;
+    uint16_t odr;
+} SimEvent;
+
+static const LED_Geometry *geo;
+static uint64_t on_ns[LED_MAX_ROWS][LED_MAX_COLS];
+static uint64_t row_on_ns[LED_MAX_ROWS];
+static uint64_t linger_until[LED_MAX_ROWS];
+static uint32_t rng = 1u;
+
+HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef *htim)
+{
+    htim->Instance->DIER |= 1u;
+    htim->Instance->CR1 |= 1u;
+    return HAL_OK;
+}
+
+static uint32_t sim_rand(void)
+{
+    rng = rng * 1664525u + 1013904223u;
+    return rng >> 8;
+}
+
+static uint16_t apply_bsrr(uint16_t odr, uint32_t bsrr)
+{
+    // 同一引脚同时置位与复位时置位优先
+    odr = (uint16_t)(odr & ~(bsrr >> 16));
+    return (uint16_t)(odr | (bsrr & 0xFFFFu));
+}
+
+static int pin_active(uint16_t odr, uint16_t pin, uint8_t active_high)
+{
+    return ((odr & pin) != 0) == (active_high != 0);
+}
+
+// 在 [t0, t1) 内以状态 odr 积分各 LED 的点亮时间，已关断但仍在拖尾的行同样计入
+static void integrate(uint16_t odr, uint64_t t0, uint64_t t1)
+{
+    for (uint8_t r = 0; r < geo->rows; r++) {
+        uint64_t dur = 0;
+        if (pin_active(odr, geo->row_pins[r], geo->row_active_high)) {
+            dur = t1 - t0;
+            row_on_ns[r] += dur;
+        } else if (linger_until[r] > t0) {
+            dur = (linger_until[r] < t1 ? linger_until[r] : t1) - t0;
+        }
+        if (dur == 0) {
+            continue;
+        }
+        for (uint8_t c = 0; c < geo->cols; c++) {
+            if (pin_active(odr, geo->col_pins[c], geo->col_active_high)) {
+                on_ns[r][c] += dur;
+            }
+        }
+    }
+}
+
+static int parse_vram(const char *arg)
+{
+    char *end;
+    uint8_t row = 0;
+
+    memset(vram, 0, sizeof(vram));
+    while (*arg != '\0' && row < LED_MAX_ROWS) {
+        vram[row++] = (uint8_t)strtoul(arg, &end, 16);
+        if (end == arg) {
+            return -1;
+        }
+        arg = (*end == ',') ? end + 1 : end;
+    }
+    return 0;
+}
+
+static int write_ppm(const char *path, double full_scale)
+{
+    const int cell = 16;
+    FILE *f = fopen(path, "wb");
+    if (f == NULL) {
+        return -1;
+    }
+    fprintf(f, "P6\n%d %d\n255\n", geo->cols * cell, geo->rows * cell);
+    for (int y = 0; y < geo->rows * cell; y++) {
+        for (int x = 0; x < geo->cols * cell; x++) {
+            double duty = (double)on_ns[y / cell][x / cell];
+            int v = (int)(255.0 * duty / full_scale + 0.5);
+            unsigned char px[3] = {(unsigned char)(v > 255 ? 255 : v), 0, 0};
+            fwrite(px, 1, sizeof(px), f);
+        }
+    }
+    fclose(f);
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    unsigned frames = 100;
+    unsigned brightness = LED_BRIGHTNESS_MAX;
+    unsigned latency_ns = 0;
+    unsigned jitter_ns = 0;
+    unsigned ghost_ns = 0;
+    const char *ppm_path = NULL;
+    const char *log_path = NULL;
+    int check = 0;
+    int opt;
+
+    parse_vram("5b,cf,6d,40,40,40");
+    while ((opt = getopt(argc, argv, "f:b:v:l:j:g:p:r:c")) != -1) {
+        switch (opt) {
+        case 'f': frames = (unsigned)strtoul(optarg, NULL, 0); break;
+        case 'b': brightness = (unsigned)strtoul(optarg, NULL, 0); break;
+        case 'v':
+            if (parse_vram(optarg) != 0) {
+                fprintf(stderr, "bad -v value: %s\n", optarg);
+                return 2;
+            }
+            break;
+        case 'l': latency_ns = (unsigned)strtoul(optarg, NULL, 0); break;
+        case 'j': jitter_ns = (unsigned)strtoul(optarg, NULL, 0); break;
+        case 'g': ghost_ns = (unsigned)strtoul(optarg, NULL, 0); break;
+        case 'p': ppm_path = optarg; break;
+        case 'r': log_path = optarg; break;
+        case 'c': check = 1; break;
+        default:
+            fprintf(stderr, "usage: %s [-f frames] [-b brightness] [-v hex,...] [-l ns] [-j ns] "
+                            "[-g ns] [-p out.ppm] [-r log.csv] [-c]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (frames == 0) {
+        frames = 1;
+    }
+
+    geo = &LED_DefaultGeometry;
+    if (LED_Init(NULL) != HAL_OK) {
+        fprintf(stderr, "LED_Init failed\n");
+        return 2;
+    }
+    uint16_t odr = apply_bsrr(0, sim_gpiob.BSRR);
+    sim_gpiob.BSRR = 0;
+
+    LED_SetBrightness((uint8_t)brightness);
+    LED_Present();
+
+    TIM_HandleTypeDef htim = {.Instance = TIM2};
+    if (LED_Start(&htim) != HAL_OK) {
+        fprintf(stderr, "LED_Start failed\n");
+        return 2;
+    }
+    uint32_t shadow_arr = sim_tim2.ARR;   // UG 已把预装载值装入影子寄存器
+
+    FILE *log = NULL;
+    if (log_path != NULL) {
+        log = fopen(log_path, "w");
+        if (log == NULL) {
+            perror(log_path);
+            return 2;
+        }
+        fprintf(log, "t_ns,bsrr,odr\n");
+    }
+
+    const unsigned slices = (unsigned)geo->rows * LED_BCM_BITS;
+    const unsigned isr_count = frames * slices + 1u;
+    uint64_t t_update = 0;
+    uint64_t t_prev = 0;
+    uint64_t t_start = 0;
+    unsigned events = 0;
+
+    for (unsigned k = 0; k < isr_count; k++) {
+        // 更新事件：影子 ARR 取预装载值，随后中断写入下一片的预装载值
+        t_update += (uint64_t)(shadow_arr + 1u) * TICK_NS;
+        shadow_arr = sim_tim2.ARR;
+
+        sim_gpiob.BSRR = 0;
+        LED_UpdateDisplay(&htim);
+        uint64_t t_write = t_update + latency_ns + (jitter_ns ? sim_rand() % jitter_ns : 0u);
+        if (t_write < t_prev) {
+            t_write = t_prev;
+        }
+
+        if (k == 0) {
+            t_start = t_write;
+        } else {
+            integrate(odr, t_prev, t_write);
+        }
+
+        uint16_t next = apply_bsrr(odr, sim_gpiob.BSRR);
+        for (uint8_t r = 0; r < geo->rows; r++) {
+            if (pin_active(odr, geo->row_pins[r], geo->row_active_high)
+                && !pin_active(next, geo->row_pins[r], geo->row_active_high)) {
+                linger_until[r] = t_write + ghost_ns;
+            }
+        }
+        if (next != odr) {
+            events++;
+            if (log != NULL) {
+                fprintf(log, "%llu,0x%08lx,0x%04x\n", (unsigned long long)t_write,
+                        (unsigned long)sim_gpiob.BSRR, next);
+            }
+        }
+        odr = next;
+        t_prev = t_write;
+    }
+    if (log != NULL) {
+        fclose(log);
+    }
+
+    const double window = (double)(t_prev - t_start);
+    const double fps = frames / (window * 1e-9);
+    const double ideal_full = window / geo->rows;     // 最高亮度下单个 LED 的点亮时间
+    const double ideal = ideal_full * LED_GetBrightness() / LED_BRIGHTNESS_MAX;
+    double lit_energy = 0.0;
+    double ghost_energy = 0.0;
+    double max_error = 0.0;
+
+    printf("frames %u, %u ODR changes, frame rate %.1f Hz, brightness %u/%u\n",
+           frames, events, fps, LED_GetBrightness(), LED_BRIGHTNESS_MAX);
+    printf("duty map (%% of full-brightness on-time):\n");
+    for (uint8_t r = 0; r < geo->rows; r++) {
+        printf("  row %u  vram %02x  on %7.1f us/frame |", r, vram[r], row_on_ns[r] / 1000.0 / frames);
+        for (uint8_t c = 0; c < geo->cols; c++) {
+            double d = (double)on_ns[r][c];
+            int lit = (vram[r] >> c) & 1u;
+            printf(" %5.1f", 100.0 * d / ideal_full);
+            if (lit) {
+                lit_energy += d;
+                double err = (d - ideal) / ideal_full;
+                if (err < 0) {
+                    err = -err;
+                }
+                if (err > max_error) {
+                    max_error = err;
+                }
+            } else {
+                ghost_energy += d;
+            }
+        }
+        printf("\n");
+    }
+
+    printf("ascii:\n");
+    for (uint8_t r = 0; r < geo->rows; r++) {
+        static const char shades[] = " .:-=+*#%@";
+        printf("  ");
+        for (uint8_t c = 0; c < geo->cols; c++) {
+            int i = (int)(9.0 * on_ns[r][c] / ideal_full + 0.5);
+            putchar(shades[i > 9 ? 9 : i]);
+        }
+        printf("\n");
+    }
+
+    const double ghost_ratio = lit_energy > 0 ? ghost_energy / lit_energy : (ghost_energy > 0 ? 1.0 : 0.0);
+    printf("ghosting energy %.1f ns/frame (%.3f%% of lit energy), max duty error %.3f%%\n",
+           ghost_energy / frames, 100.0 * ghost_ratio, 100.0 * max_error);
+
+    if (ppm_path != NULL && write_ppm(ppm_path, ideal_full) != 0) {
+        perror(ppm_path);
+        return 2;
+    }
+
+    if (check) {
+        int fail = 0;
+        if (fps < 100.0) {
+            printf("FAIL: frame rate %.1f Hz < 100 Hz\n", fps);
+            fail = 1;
+        }
+        if (ghost_ratio > 0.01) {
+            printf("FAIL: ghosting energy %.3f%% > 1%%\n", 100.0 * ghost_ratio);
+            fail = 1;
+        }
+        if (max_error > 0.02) {
+            printf("FAIL: duty error %.3f%% > 2%%\n", 100.0 * max_error);
+            fail = 1;
+        }
+        return fail;
+    }
+    return 0;
+}
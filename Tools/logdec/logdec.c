@@ -0,0 +1,214 @@
+/**
+ * @file  logdec.c
+ * @brief 遥测流中二进制日志（Core/Inc/log.h）的主机端解码器
+ *
+ * 从 DEV.elf 读出不装载的 .log_fmt 段，按 0 分隔切出 COBS 帧并校验 CRC16，
+ * 对 TLM_CH_LOG 帧中的每条记录按格式串在主机上格式化，TLM_CH_TEXT 帧原样输出，其他通道忽略。
+ *
+ * 编译（仓库根目录）：
+ *   cc -std=c11 -O2 -ITools/common -o logdec Tools/logdec/logdec.c
+ *
+ * 用法：logdec [-f 内核时钟Hz] DEV.elf [抓包文件]
+ *   未给抓包文件时读标准输入，例如：
+ *   stty -F /dev/ttyUSB0 921600 raw && logdec build/DEV.elf < /dev/ttyUSB0
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "tlmhost.h"
+
+static TlmSection fmt_sec;
+static double cpu_hz = 72e6;
+static uint64_t ts_base;
+static uint32_t ts_last;
+static uint32_t dropped_seen;
+static unsigned long bad_frames;
+
+// 按 printf 规则格式化一条记录，参数不足时输出占位符
+static void print_formatted(const char *fmt, const uint32_t *args, unsigned nargs)
+{
+    unsigned next = 0;
+    while (*fmt != '\0') {
+        if (*fmt != '%') {
+            putchar(*fmt++);
+            continue;
+        }
+        if (fmt[1] == '%') {
+            putchar('%');
+            fmt += 2;
+            continue;
+        }
+        // 复制标志、宽度、精度，丢弃长度修饰（参数总是 32 位）
+        char spec[32];
+        size_t n = 0;
+        spec[n++] = *fmt++;
+        while (*fmt != '\0' && strchr("-+ #0123456789.", *fmt) != NULL && n < sizeof(spec) - 3u) {
+            spec[n++] = *fmt++;
+        }
+        while (*fmt != '\0' && strchr("hlLqjzt", *fmt) != NULL) {
+            fmt++;
+        }
+        char conv = *fmt;
+        if (conv == '\0') {
+            break;
+        }
+        fmt++;
+        spec[n++] = conv;
+        spec[n] = '\0';
+
+        if (next >= nargs) {
+            printf("<missing>");
+            continue;
+        }
+        uint32_t v = args[next++];
+        switch (conv) {
+        case 'd':
+        case 'i':
+            printf(spec, (int)(int32_t)v);
+            break;
+        case 'u':
+        case 'x':
+        case 'X':
+        case 'o':
+        case 'c':
+            printf(spec, (unsigned)v);
+            break;
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A': {
+            float fv;
+            memcpy(&fv, &v, sizeof(fv));
+            printf(spec, (double)fv);
+            break;
+        }
+        case 'p':
+            printf("0x%08x", (unsigned)v);
+            break;
+        default:
+            printf("<%%%c 0x%08x>", conv, (unsigned)v);
+            break;
+        }
+    }
+}
+
+static void print_record(uint32_t hdr, uint32_t ts, const uint32_t *args)
+{
+    uint32_t id = hdr & 0xFFFFu;
+    unsigned nargs = (unsigned)(hdr >> 16);
+    uint32_t offset = (uint32_t)((id - fmt_sec.addr) & 0xFFFFu);
+
+    if (ts < ts_last) {
+        ts_base += 1ull << 32;      // CYCCNT 约 60s 回绕一次，相邻记录间隔须小于一个周期
+    }
+    ts_last = ts;
+    printf("[%12.6f] ", (double)(ts_base + ts) / cpu_hz);
+
+    if (offset >= fmt_sec.size) {
+        printf("? unknown id 0x%04x", (unsigned)id);
+        for (unsigned i = 0; i < nargs; i++) {
+            printf(" 0x%08x", (unsigned)args[i]);
+        }
+        putchar('\n');
+        return;
+    }
+    // "级别|文件:行|格式"
+    const char *entry = (const char *)fmt_sec.data + offset;
+    const char *bar1 = strchr(entry, '|');
+    const char *bar2 = bar1 != NULL ? strchr(bar1 + 1, '|') : NULL;
+    if (bar2 == NULL) {
+        printf("? malformed id 0x%04x\n", (unsigned)id);
+        return;
+    }
+    const char *file = bar1 + 1;
+    const char *slash = file;
+    for (const char *p = file; p < bar2; p++) {
+        if (*p == '/' || *p == '\\') {
+            slash = p + 1;
+        }
+    }
+    printf("%.*s %.*s  ", (int)(bar1 - entry), entry, (int)(bar2 - slash), slash);
+    print_formatted(bar2 + 1, args, nargs);
+    putchar('\n');
+}
+
+static void handle_frame(uint8_t channel, const uint8_t *payload, size_t size)
+{
+    if (channel == TLM_HOST_CH_TEXT) {
+        printf("%.*s", (int)size, (const char *)payload);
+        fflush(stdout);
+        return;
+    }
+    if (channel != TLM_HOST_CH_LOG || size < 4u || size % 4u != 0) {
+        return;
+    }
+
+    uint32_t words[TLM_HOST_FRAME_MAX / 4u];
+    const size_t count = size / 4u;
+    for (size_t i = 0; i < count; i++) {
+        words[i] = (uint32_t)tlm_get_le(payload + 4u * i, 4);
+    }
+    if (words[0] != dropped_seen) {
+        printf("[  ---------- ] %u records dropped on target\n", (unsigned)(words[0] - dropped_seen));
+        dropped_seen = words[0];
+    }
+    for (size_t i = 1; i + 2u <= count;) {
+        unsigned nargs = (unsigned)(words[i] >> 16);
+        if (i + 2u + nargs > count) {
+            bad_frames++;
+            break;
+        }
+        print_record(words[i], words[i + 1u], &words[i + 2u]);
+        i += 2u + nargs;
+    }
+    fflush(stdout);
+}
+
+int main(int argc, char **argv)
+{
+    int opt;
+    while ((opt = getopt(argc, argv, "f:")) != -1) {
+        switch (opt) {
+        case 'f': cpu_hz = strtod(optarg, NULL); break;
+        default:
+            fprintf(stderr, "usage: %s [-f hz] DEV.elf [capture]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (optind >= argc || cpu_hz <= 0) {
+        fprintf(stderr, "usage: %s [-f hz] DEV.elf [capture]\n", argv[0]);
+        return 2;
+    }
+    TlmElf elf;
+    if (tlm_elf_open(argv[optind], &elf) != 0) {
+        return 2;
+    }
+    if (tlm_elf_section(&elf, ".log_fmt", &fmt_sec) != 0) {
+        fprintf(stderr, "%s: no .log_fmt section\n", argv[optind]);
+        return 2;
+    }
+    FILE *in = stdin;
+    if (optind + 1 < argc && (in = fopen(argv[optind + 1], "rb")) == NULL) {
+        perror(argv[optind + 1]);
+        return 2;
+    }
+
+    uint8_t raw[TLM_HOST_FRAME_MAX];
+    int len;
+    while ((len = tlm_read_frame(in, raw, &bad_frames)) >= 0) {
+        handle_frame(raw[0], raw + 1, (size_t)len);
+    }
+    if (bad_frames != 0) {
+        fprintf(stderr, "%lu bad frames\n", bad_frames);
+    }
+    return 0;
+}
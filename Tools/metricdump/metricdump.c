@@ -0,0 +1,204 @@
+/**
+ * @file  metricdump.c
+ * @brief 指标注册表（Core/Inc/metrics.h）快照的主机端解码器
+ *
+ * 从 DEV.elf 的不装载段 .metrics_schema 读出每个指标的名称、类型和地址，
+ * 把遥测流中 TLM_CH_METRICS 的分片按快照序号拼回整块，按模式逐项打印；
+ * 计数器同时给出与上一个快照相比的增量。
+ *
+ * 编译（仓库根目录）：
+ *   cc -std=c11 -O2 -ITools/common -o metricdump Tools/metricdump/metricdump.c
+ *
+ * 用法：metricdump [-n 快照数] DEV.elf [抓包文件]
+ *   未给抓包文件时读标准输入；-n 打印指定个数的快照后退出
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "tlmhost.h"
+
+// 与 metrics.h 一致
+#define TYPE_COUNTER   1u
+#define TYPE_GAUGE     2u
+#define TYPE_HISTOGRAM 3u
+#define NAME_LEN       24u
+#define HEADER_SIZE    12u      // METRIC_Header
+#define BLOCK_MAX      4096u
+
+typedef struct {
+    uint64_t addr;
+    uint8_t type;
+    uint8_t count;
+    char name[NAME_LEN + 1u];
+} Metric;
+
+static Metric *metrics;
+static size_t metric_count;
+
+static uint8_t block[BLOCK_MAX];
+static uint8_t prev_block[BLOCK_MAX];
+static int have_prev;
+static uint32_t cur_seq;
+static uint32_t cur_len;        // 当前快照已按序收到的字节数，中间丢帧时作废
+
+// METRIC_Desc：指针、type、count、2 字节保留、名称；按指针宽度对齐
+static int load_schema(const TlmElf *elf)
+{
+    TlmSection sec;
+    if (tlm_elf_section(elf, ".metrics_schema", &sec) != 0) {
+        return -1;
+    }
+    const unsigned ptr = (elf->image[4] == 2) ? 8u : 4u;
+    const unsigned entry = (ptr + 4u + NAME_LEN + ptr - 1u) / ptr * ptr;
+
+    metric_count = (size_t)(sec.size / entry);
+    metrics = calloc(metric_count ? metric_count : 1u, sizeof(Metric));
+    if (metrics == NULL) {
+        return -1;
+    }
+    for (size_t i = 0; i < metric_count; i++) {
+        const uint8_t *d = sec.data + i * entry;
+        Metric *m = &metrics[i];
+        m->addr = tlm_get_le(d, ptr);
+        m->type = d[ptr];
+        m->count = d[ptr + 1u];
+        memcpy(m->name, d + ptr + 4u, NAME_LEN);     // 名称恰为 24 字符时没有结尾 0
+    }
+    return 0;
+}
+
+static uint32_t word_at(const uint8_t *blk, uint64_t offset)
+{
+    return (uint32_t)tlm_get_le(blk + offset, 4);
+}
+
+static void print_snapshot(uint32_t base, uint32_t seq, uint32_t total)
+{
+    printf("snapshot %u (%u bytes)\n", (unsigned)seq, (unsigned)total);
+    for (size_t i = 0; i < metric_count; i++) {
+        const Metric *m = &metrics[i];
+        uint64_t offset = (uint32_t)(m->addr - base);
+        uint64_t bytes = 4u * (uint64_t)(m->count ? m->count : 1u);
+        if (offset + bytes > total) {
+            printf("  %-23s <outside block>\n", m->name);
+            continue;
+        }
+        switch (m->type) {
+        case TYPE_COUNTER: {
+            uint32_t v = word_at(block, offset);
+            printf("  %-23s counter   %10u", m->name, (unsigned)v);
+            if (have_prev) {
+                printf("  +%u", (unsigned)(v - word_at(prev_block, offset)));
+            }
+            putchar('\n');
+            break;
+        }
+        case TYPE_GAUGE:
+            printf("  %-23s gauge     %10d\n", m->name, (int)(int32_t)word_at(block, offset));
+            break;
+        case TYPE_HISTOGRAM:
+            printf("  %-23s histogram", m->name);
+            for (unsigned b = 0; b < m->count; b++) {
+                uint32_t v = word_at(block, offset + 4u * b);
+                if (v == 0) {
+                    continue;
+                }
+                if (b == 0) {
+                    printf("  0:%u", (unsigned)v);
+                } else if (b + 1u == m->count) {
+                    printf("  >=%lu:%u", 1ul << (b - 1u), (unsigned)v);
+                } else {
+                    printf("  <%lu:%u", 1ul << b, (unsigned)v);
+                }
+            }
+            putchar('\n');
+            break;
+        default:
+            printf("  %-23s type %u?\n", m->name, m->type);
+            break;
+        }
+    }
+    fflush(stdout);
+    memcpy(prev_block, block, total);
+    have_prev = 1;
+}
+
+// 返回 1 表示拼出了一个完整快照
+static int handle_frame(const uint8_t *payload, size_t size)
+{
+    if (size < HEADER_SIZE) {
+        return 0;
+    }
+    uint32_t base = (uint32_t)tlm_get_le(payload, 4);
+    uint32_t seq = (uint32_t)tlm_get_le(payload + 4, 4);
+    uint32_t offset = (uint32_t)tlm_get_le(payload + 8, 2);
+    uint32_t total = (uint32_t)tlm_get_le(payload + 10, 2);
+    uint32_t len = (uint32_t)(size - HEADER_SIZE);
+
+    if (total > BLOCK_MAX || offset + len > total) {
+        return 0;
+    }
+    if (offset == 0) {
+        cur_seq = seq;
+        cur_len = 0;
+    }
+    if (seq != cur_seq || offset != cur_len) {
+        return 0;       // 丢了前面的分片，等下一个快照
+    }
+    memcpy(block + offset, payload + HEADER_SIZE, len);
+    cur_len = offset + len;
+    if (cur_len < total) {
+        return 0;
+    }
+    print_snapshot(base, seq, total);
+    return 1;
+}
+
+int main(int argc, char **argv)
+{
+    long limit = -1;
+    int opt;
+    while ((opt = getopt(argc, argv, "n:")) != -1) {
+        switch (opt) {
+        case 'n': limit = strtol(optarg, NULL, 0); break;
+        default:
+            fprintf(stderr, "usage: %s [-n count] DEV.elf [capture]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (optind >= argc) {
+        fprintf(stderr, "usage: %s [-n count] DEV.elf [capture]\n", argv[0]);
+        return 2;
+    }
+    TlmElf elf;
+    if (tlm_elf_open(argv[optind], &elf) != 0) {
+        return 2;
+    }
+    if (load_schema(&elf) != 0) {
+        fprintf(stderr, "%s: no .metrics_schema section\n", argv[optind]);
+        return 2;
+    }
+    FILE *in = stdin;
+    if (optind + 1 < argc && (in = fopen(argv[optind + 1], "rb")) == NULL) {
+        perror(argv[optind + 1]);
+        return 2;
+    }
+
+    uint8_t raw[TLM_HOST_FRAME_MAX];
+    unsigned long bad_frames = 0;
+    int len;
+    while (limit != 0 && (len = tlm_read_frame(in, raw, &bad_frames)) >= 0) {
+        if (raw[0] == TLM_HOST_CH_METRICS && handle_frame(raw + 1, (size_t)len) && limit > 0) {
+            limit--;
+        }
+    }
+    if (bad_frames != 0) {
+        fprintf(stderr, "%lu bad frames\n", bad_frames);
+    }
+    return 0;
+}
@@ -0,0 +1,182 @@
+/**
+ * @file  spsc_stress.cpp
+ * @brief SpscRing（Core/Inc/spsc_ring.hpp）的双线程压力测试
+ *
+ * 一个线程生产、一个线程消费，随机混用单个、整段拷贝和零拷贝（span）三种接口，
+ * 元素为序号及其校验字。消费端逐个核对：序号不连续即丢失或乱序，校验字不符即读到了
+ * 尚未写完的槽（发布顺序错误）。容量取小值，使队列频繁在满和空之间切换、跨越绕回点。
+ * 用 -fsanitize=thread 编译可同时检查数据竞争。
+ *
+ * 编译（仓库根目录）：
+ *   c++ -std=c++17 -O2 -pthread -ICore/Inc -o spsc_stress Tools/spsc_stress/spsc_stress.cpp
+ *
+ * 用法：spsc_stress [-n 元素数]
+ *   默认 2000000 个元素，任一容量出错时返回 1
+ */
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <unistd.h>
+
+#include "spsc_ring.hpp"
+
+namespace {
+
+struct Item {
+    uint32_t seq;
+    uint32_t check;
+};
+
+constexpr uint32_t check_of(uint32_t seq)
+{
+    return ~seq * 2654435761u;
+}
+
+// 两端各用独立的 xorshift32，选择操作和批量大小
+uint32_t next_random(uint32_t &state)
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+template <std::size_t N>
+void produce(SpscRing<Item, N> &ring, uint32_t total)
+{
+    uint32_t rng = 0x12345678u;
+    Item batch[N];
+    uint32_t seq = 0;
+
+    while (seq < total) {
+        const uint32_t before = seq;
+        const uint32_t r = next_random(rng);
+        const uint32_t want = 1u + (r >> 8) % N;
+        switch (r % 3u) {
+        case 0:
+            if (ring.push(Item{seq, check_of(seq)})) {
+                seq++;
+            }
+            break;
+        case 1: {
+            uint32_t n = want < total - seq ? want : total - seq;
+            for (uint32_t i = 0; i < n; i++) {
+                batch[i] = Item{seq + i, check_of(seq + i)};
+            }
+            seq += ring.push(batch, n);
+            break;
+        }
+        default: {
+            auto span = ring.write_span();
+            uint32_t n = span.size < total - seq ? span.size : total - seq;
+            if (n > want) {
+                n = want;
+            }
+            for (uint32_t i = 0; i < n; i++) {
+                span.data[i] = Item{seq + i, check_of(seq + i)};
+            }
+            ring.commit(n);
+            seq += n;
+            break;
+        }
+        }
+        if (seq == before) {
+            std::this_thread::yield();      // 队列满，单核主机上让出给消费者
+        }
+    }
+}
+
+// 返回出错的元素数
+template <std::size_t N>
+uint32_t consume(SpscRing<Item, N> &ring, uint32_t total)
+{
+    uint32_t rng = 0x9E3779B9u;
+    Item batch[N];
+    uint32_t expect = 0;
+    uint32_t errors = 0;
+
+    auto verify = [&](const Item &item) {
+        if (item.seq != expect || item.check != check_of(item.seq)) {
+            if (errors++ < 10) {
+                std::fprintf(stderr, "N=%zu: expected %" PRIu32 ", got seq %" PRIu32 " check %08" PRIx32 "\n",
+                             N, expect, item.seq, item.check);
+            }
+            expect = item.seq;
+        }
+        expect++;
+    };
+
+    while (expect < total) {
+        const uint32_t before = expect;
+        const uint32_t r = next_random(rng);
+        const uint32_t want = 1u + (r >> 8) % N;
+        switch (r % 3u) {
+        case 0: {
+            Item item;
+            if (ring.pop(item)) {
+                verify(item);
+            }
+            break;
+        }
+        case 1: {
+            uint32_t n = ring.pop(batch, want);
+            for (uint32_t i = 0; i < n; i++) {
+                verify(batch[i]);
+            }
+            break;
+        }
+        default: {
+            auto span = ring.read_span();
+            uint32_t n = span.size < want ? span.size : want;
+            for (uint32_t i = 0; i < n; i++) {
+                verify(span.data[i]);
+            }
+            ring.consume(n);
+            break;
+        }
+        }
+        if (expect == before) {
+            std::this_thread::yield();      // 队列空
+        }
+    }
+    if (!ring.empty()) {
+        std::fprintf(stderr, "N=%zu: %" PRIu32 " extra elements\n", N, ring.size());
+        errors++;
+    }
+    return errors;
+}
+
+template <std::size_t N>
+uint32_t run(uint32_t total)
+{
+    static SpscRing<Item, N> ring;
+    uint32_t errors = 0;
+
+    std::thread producer([&] { produce(ring, total); });
+    std::thread consumer([&] { errors = consume(ring, total); });
+    producer.join();
+    consumer.join();
+    std::printf("N=%-4zu %" PRIu32 " elements, %" PRIu32 " errors\n", N, total, errors);
+    return errors;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    uint32_t total = 2000000u;
+    int opt;
+    while ((opt = getopt(argc, argv, "n:")) != -1) {
+        switch (opt) {
+        case 'n': total = static_cast<uint32_t>(std::strtoul(optarg, nullptr, 0)); break;
+        default:
+            std::fprintf(stderr, "usage: %s [-n count]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    uint32_t errors = run<2>(total) + run<8>(total) + run<64>(total);
+    return errors != 0 ? 1 : 0;
+}
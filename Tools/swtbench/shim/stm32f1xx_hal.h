@@ -0,0 +1,42 @@
+/**
+ * @file  stm32f1xx_hal.h
+ * @brief 主机基准测试用的最小 HAL 替身：只提供 swtimer.c 与 irq.h 用到的定义。
+ *        BASEPRI 是普通变量，单线程运行时临界区只剩读写它的开销。
+ */
+#ifndef SIM_STM32F1XX_HAL_H
+#define SIM_STM32F1XX_HAL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef enum {
+    HAL_OK = 0x00U,
+    HAL_ERROR = 0x01U,
+    HAL_BUSY = 0x02U,
+    HAL_TIMEOUT = 0x03U
+} HAL_StatusTypeDef;
+
+#define __weak __attribute__((weak))
+
+#define TICK_INT_PRIORITY 2U
+
+extern uint32_t sim_basepri;
+
+static inline uint32_t __get_BASEPRI(void)
+{
+    return sim_basepri;
+}
+
+static inline void __set_BASEPRI(uint32_t value)
+{
+    sim_basepri = value;
+}
+
+static inline void __set_BASEPRI_MAX(uint32_t value)
+{
+    if (value != 0 && (sim_basepri == 0 || value < sim_basepri)) {
+        sim_basepri = value;
+    }
+}
+
+#endif // SIM_STM32F1XX_HAL_H
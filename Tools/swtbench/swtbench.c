@@ -0,0 +1,148 @@
+/**
+ * @file  swtbench.c
+ * @brief 软件定时器时间轮（Core/Src/swtimer.c）的主机基准测试
+ *
+ * 直接链接 swtimer.c 和 mono.c（主机上走 CLOCK_MONOTONIC 分支），shim/ 中的 HAL 替身把
+ * BASEPRI 换成普通变量。对 1、2、4 … 256 个已启动的周期定时器分别测量：
+ *   start+stop  在已有 n 个定时器时启动并停止一个随机延时的定时器
+ *   tick        SWT_Tick 加 SWT_Process 的平均耗时（含级联和回调重排）
+ * 同时检查每次回调都恰好发生在应到期的 tick，有任何提前、延迟或漏掉时返回 1。
+ * 时间轮是 O(1) 的：start+stop 不随 n 变化；tick 只随到期次数（fired 列，每次到期要回调并重排）增加，
+ * 与已启动但未到期的定时器数无关。
+ *
+ * 编译（仓库根目录）：
+ *   cc -std=c11 -O2 -ITools/swtbench/shim -ICore/Inc -o swtbench Tools/swtbench/swtbench.c Core/Src/swtimer.c Core/Src/mono.c
+ *
+ * 用法：swtbench [-t 每档模拟的 tick 数]
+ *   默认 1200000 个 tick（20 分钟，覆盖第2层级联）
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "swtimer.h"
+#include "mono.h"
+
+#define MAX_TIMERS 256u
+#define PROBES     100000u
+
+uint32_t sim_basepri;
+
+typedef struct {
+    SWT_Timer timer;
+    uint32_t due;           // 下一次应到期的 SWT_Now()
+    uint32_t period;
+} BenchTimer;
+
+static BenchTimer timers[MAX_TIMERS];
+static uint32_t fired;
+static uint32_t errors;
+static uint32_t rng = 0x2545F491u;
+
+static uint32_t next_random(void)
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+// 延时分布覆盖三层：多数落在第0层，其余在第1、2层
+static uint32_t random_delay(void)
+{
+    uint32_t r = next_random();
+    switch (r & 3u) {
+    case 0:
+    case 1:
+        return 1u + (r >> 2) % 255u;
+    case 2:
+        return 256u + (r >> 2) % 16128u;
+    default:
+        return 16384u + (r >> 2) % 1000000u;
+    }
+}
+
+static void on_expire(SWT_Timer *timer, void *arg)
+{
+    BenchTimer *t = arg;
+    (void)timer;
+    if (SWT_Now() != t->due) {
+        if (errors++ < 10) {
+            fprintf(stderr, "timer %u: due %u, fired at %u\n",
+                    (unsigned)(t - timers), (unsigned)t->due, (unsigned)SWT_Now());
+        }
+    }
+    t->due += t->period;
+    fired++;
+}
+
+static void run(uint32_t n, uint32_t ticks)
+{
+    SWT_Timer probe = {0};
+
+    SWT_Init();
+    fired = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        BenchTimer *t = &timers[i];
+        uint32_t delay = random_delay();
+        t->period = random_delay();
+        t->due = SWT_Now() + delay;
+        t->timer.state = 0;
+        SWT_Start(&t->timer, delay, t->period, on_expire, t);
+    }
+
+    uint64_t t0 = MONO_Ns();
+    for (uint32_t i = 0; i < PROBES; i++) {
+        SWT_Start(&probe, random_delay(), 0, on_expire, NULL);
+        SWT_Stop(&probe);
+    }
+    uint64_t t1 = MONO_Ns();
+    for (uint32_t i = 0; i < ticks; i++) {
+        SWT_Tick();
+        SWT_Process();
+    }
+    uint64_t t2 = MONO_Ns();
+
+    // 漏掉的到期会让 due 停在当前时刻之前
+    for (uint32_t i = 0; i < n; i++) {
+        const BenchTimer *t = &timers[i];
+        if ((int32_t)(t->due - SWT_Now()) <= 0) {
+            if (errors++ < 10) {
+                fprintf(stderr, "timer %u: missed expiry at %u\n", (unsigned)i, (unsigned)t->due);
+            }
+        }
+    }
+
+    printf("%6u %14.1f %10.1f %10u\n", (unsigned)n,
+           (double)(t1 - t0) / PROBES, (double)(t2 - t1) / ticks, (unsigned)fired);
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t ticks = 1200000u;
+    int opt;
+    while ((opt = getopt(argc, argv, "t:")) != -1) {
+        switch (opt) {
+        case 't': ticks = (uint32_t)strtoul(optarg, NULL, 0); break;
+        default:
+            fprintf(stderr, "usage: %s [-t ticks]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    if (MONO_Init() != 0) {
+        fprintf(stderr, "MONO_Init failed\n");
+        return 2;
+    }
+    printf("timers  start+stop ns    tick ns      fired\n");
+    for (uint32_t n = 1; n <= MAX_TIMERS; n *= 2) {
+        run(n, ticks);
+    }
+    if (errors != 0) {
+        fprintf(stderr, "%u expiries off their tick\n", (unsigned)errors);
+        return 1;
+    }
+    return 0;
+}
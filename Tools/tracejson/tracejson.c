@@ -0,0 +1,276 @@
+/**
+ * @file  tracejson.c
+ * @brief 事件跟踪（Core/Inc/trace.h）转储的主机端转换器，输出 Chrome trace JSON
+ *
+ * 从遥测流中取 TLM_CH_TRACE 的头帧和事件帧，按转储序号拼回整个环，
+ * 展开 32 位周期计数并按时间排序后输出：
+ *   中断的进入/退出为线程 "isr" 上的 B/E 事件，任务的开始/结束为线程 "tasks" 上的 B/E 事件，
+ *   队列溢出和标记为线程 "events" 上的瞬时事件。
+ * 结果用 chrome://tracing 或 https://ui.perfetto.dev 打开。
+ *
+ * 编译（仓库根目录）：
+ *   cc -std=c11 -O2 -ITools/common -o tracejson Tools/tracejson/tracejson.c
+ *
+ * 用法：tracejson [-o 输出文件] [抓包文件]
+ *   未给抓包文件时读标准输入；流中有多次转储时转换最后一次完整的
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "tlmhost.h"
+
+// 与 trace.h 一致
+#define KIND_HEADER 0u
+#define KIND_EVENTS 1u
+#define HEADER_SIZE 12u         // TRACE_DumpHeader
+#define CHUNK_SIZE  8u          // TRACE_DumpChunk
+#define NAME_LEN    8u
+#define MAX_TASKS   32u
+#define MAX_EVENTS  4096u
+
+enum { TASK_START = 1, TASK_END, ISR_ENTER, ISR_EXIT, OVERFLOW, MARK };
+enum { TID_ISR = 1, TID_TASKS, TID_EVENTS };
+
+// 与 isrprof.h 的 PROF_Id 一致
+static const char *const isr_names[] = { "SysTick", "TIM2", "EXTI9_5", "EXTI15_10", "PendSV", "DMA1_CH4", "ADC1_2" };
+// 与 trace.h 的 TRACE_Queue 一致
+static const char *const queue_names[] = { "key", "exti", "log", "tlm" };
+
+typedef struct {
+    uint32_t sequence;
+    uint32_t cpu_hz;
+    uint32_t count;
+    uint32_t received;          // 已按序收到的事件数，中间丢帧时作废
+    unsigned tasks;
+    char names[MAX_TASKS][NAME_LEN + 1u];
+    uint32_t cycles[MAX_EVENTS];
+    uint32_t info[MAX_EVENTS];
+} Dump;
+
+typedef struct {
+    uint64_t t;                 // 展开后的周期数
+    uint32_t info;
+    uint32_t order;             // 环中顺序，时间戳相同时保持原顺序
+} Event;
+
+static Dump cur;
+static Dump done;
+static int have_done;
+
+static void handle_frame(const uint8_t *payload, size_t size)
+{
+    if (size >= HEADER_SIZE && payload[0] == KIND_HEADER) {
+        cur.tasks = payload[1] < MAX_TASKS ? payload[1] : MAX_TASKS;
+        cur.count = (uint32_t)tlm_get_le(payload + 2, 2);
+        cur.sequence = (uint32_t)tlm_get_le(payload + 4, 4);
+        cur.cpu_hz = (uint32_t)tlm_get_le(payload + 8, 4);
+        cur.received = 0;
+        if (cur.count > MAX_EVENTS || size < HEADER_SIZE + (size_t)cur.tasks * NAME_LEN) {
+            cur.count = 0;
+            cur.cpu_hz = 0;     // 作废
+            return;
+        }
+        for (unsigned i = 0; i < cur.tasks; i++) {
+            memcpy(cur.names[i], payload + HEADER_SIZE + i * NAME_LEN, NAME_LEN);
+            cur.names[i][NAME_LEN] = '\0';
+        }
+    } else if (size >= CHUNK_SIZE && payload[0] == KIND_EVENTS) {
+        uint32_t index = (uint32_t)tlm_get_le(payload + 2, 2);
+        uint32_t seq = (uint32_t)tlm_get_le(payload + 4, 4);
+        uint32_t n = (uint32_t)((size - CHUNK_SIZE) / 8u);
+        if (cur.cpu_hz == 0 || seq != cur.sequence || index != cur.received || index + n > cur.count) {
+            return;     // 没有对应的头帧或丢了前面的事件帧
+        }
+        for (uint32_t i = 0; i < n; i++) {
+            cur.cycles[index + i] = (uint32_t)tlm_get_le(payload + CHUNK_SIZE + 8u * i, 4);
+            cur.info[index + i] = (uint32_t)tlm_get_le(payload + CHUNK_SIZE + 8u * i + 4u, 4);
+        }
+        cur.received = index + n;
+    } else {
+        return;
+    }
+    if (cur.cpu_hz != 0 && cur.received == cur.count) {
+        done = cur;
+        have_done = 1;
+    }
+}
+
+static int compare_event(const void *a, const void *b)
+{
+    const Event *x = a;
+    const Event *y = b;
+    if (x->t != y->t) {
+        return x->t < y->t ? -1 : 1;
+    }
+    return x->order < y->order ? -1 : 1;
+}
+
+static void print_json_string(FILE *out, const char *s)
+{
+    fputc('"', out);
+    for (; *s != '\0'; s++) {
+        if (*s == '"' || *s == '\\') {
+            fputc('\\', out);
+        }
+        if ((unsigned char)*s >= 0x20u) {
+            fputc(*s, out);
+        }
+    }
+    fputc('"', out);
+}
+
+static void print_event(FILE *out, int *first, const char *name, char ph, int tid, double us)
+{
+    fprintf(out, "%s\n{\"name\":", *first ? "" : ",");
+    print_json_string(out, name);
+    fprintf(out, ",\"ph\":\"%c\",\"pid\":1,\"tid\":%d,\"ts\":%.3f", ph, tid, us);
+    *first = 0;
+}
+
+static void write_json(FILE *out, const Dump *d)
+{
+    static Event events[MAX_EVENTS];
+    const double cycles_per_us = d->cpu_hz / 1e6;
+    char buf[32];
+
+    // 相邻事件相差不到 2^31 个周期（72 MHz 下约 30 s），按有符号差展开；抢占可能使时间戳略有倒退
+    uint64_t t = (uint64_t)1 << 32;
+    for (uint32_t i = 0; i < d->count; i++) {
+        if (i != 0) {
+            t += (int64_t)(int32_t)(d->cycles[i] - d->cycles[i - 1u]);
+        }
+        events[i].t = t;
+        events[i].info = d->info[i];
+        events[i].order = i;
+    }
+    qsort(events, d->count, sizeof(Event), compare_event);
+    const uint64_t t0 = d->count ? events[0].t : 0;
+
+    int first = 1;
+    fprintf(out, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+    static const char *const threads[] = { NULL, "isr", "tasks", "events" };
+    for (int tid = TID_ISR; tid <= TID_EVENTS; tid++) {
+        fprintf(out, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                first ? "" : ",", tid, threads[tid]);
+        first = 0;
+    }
+
+    // 环开头可能有缺少 B 的 E（进入发生在最旧事件之前），跳过；结尾未结束的在最后时刻补 E
+    int depth[TID_EVENTS + 1] = { 0 };
+    const char *open[TID_EVENTS + 1][16];
+    double us = 0;
+    for (uint32_t i = 0; i < d->count; i++) {
+        const unsigned type = events[i].info & 0xFFu;
+        const unsigned id = (events[i].info >> 8) & 0xFFu;
+        const unsigned arg = events[i].info >> 16;
+        us = (double)(events[i].t - t0) / cycles_per_us;
+
+        switch (type) {
+        case TASK_START:
+        case ISR_ENTER: {
+            const int tid = type == TASK_START ? TID_TASKS : TID_ISR;
+            const char *name;
+            if (type == TASK_START) {
+                name = id < d->tasks && d->names[id][0] ? d->names[id] : NULL;
+            } else {
+                name = id < sizeof(isr_names) / sizeof(isr_names[0]) ? isr_names[id] : NULL;
+            }
+            if (name == NULL) {
+                snprintf(buf, sizeof(buf), "%s%u", type == TASK_START ? "task" : "irq", id);
+                name = buf;
+            }
+            print_event(out, &first, name, 'B', tid, us);
+            fputc('}', out);
+            if (depth[tid] < 16) {
+                open[tid][depth[tid]] = name == buf ? "?" : name;
+            }
+            depth[tid]++;
+            break;
+        }
+        case TASK_END:
+        case ISR_EXIT: {
+            const int tid = type == TASK_END ? TID_TASKS : TID_ISR;
+            if (depth[tid] == 0) {
+                break;
+            }
+            depth[tid]--;
+            print_event(out, &first, depth[tid] < 16 ? open[tid][depth[tid]] : "?", 'E', tid, us);
+            fputc('}', out);
+            break;
+        }
+        case OVERFLOW:
+            if (id < sizeof(queue_names) / sizeof(queue_names[0])) {
+                snprintf(buf, sizeof(buf), "overflow %s", queue_names[id]);
+            } else {
+                snprintf(buf, sizeof(buf), "overflow %u", id);
+            }
+            print_event(out, &first, buf, 'i', TID_EVENTS, us);
+            fprintf(out, ",\"s\":\"g\",\"args\":{\"dropped\":%u}}", arg);
+            break;
+        case MARK:
+            snprintf(buf, sizeof(buf), "mark %u", id);
+            print_event(out, &first, buf, 'i', TID_EVENTS, us);
+            fprintf(out, ",\"s\":\"t\",\"args\":{\"arg\":%u}}", arg);
+            break;
+        default:
+            break;
+        }
+    }
+    for (int tid = TID_ISR; tid <= TID_TASKS; tid++) {
+        while (depth[tid] > 0) {
+            depth[tid]--;
+            print_event(out, &first, depth[tid] < 16 ? open[tid][depth[tid]] : "?", 'E', tid, us);
+            fputc('}', out);
+        }
+    }
+    fprintf(out, "\n]}\n");
+}
+
+int main(int argc, char **argv)
+{
+    const char *out_path = NULL;
+    int opt;
+    while ((opt = getopt(argc, argv, "o:")) != -1) {
+        switch (opt) {
+        case 'o': out_path = optarg; break;
+        default:
+            fprintf(stderr, "usage: %s [-o out.json] [capture]\n", argv[0]);
+            return 2;
+        }
+    }
+    FILE *in = stdin;
+    if (optind < argc && (in = fopen(argv[optind], "rb")) == NULL) {
+        perror(argv[optind]);
+        return 2;
+    }
+
+    uint8_t raw[TLM_HOST_FRAME_MAX];
+    unsigned long bad_frames = 0;
+    int len;
+    while ((len = tlm_read_frame(in, raw, &bad_frames)) >= 0) {
+        if (raw[0] == TLM_HOST_CH_TRACE) {
+            handle_frame(raw + 1, (size_t)len);
+        }
+    }
+    if (bad_frames != 0) {
+        fprintf(stderr, "%lu bad frames\n", bad_frames);
+    }
+    if (!have_done) {
+        fprintf(stderr, "no complete trace dump\n");
+        return 1;
+    }
+
+    FILE *out = stdout;
+    if (out_path != NULL && (out = fopen(out_path, "w")) == NULL) {
+        perror(out_path);
+        return 2;
+    }
+    write_json(out, &done);
+    fprintf(stderr, "dump %u: %u events\n", (unsigned)done.sequence, (unsigned)done.count);
+    return out == stdout ? 0 : (fclose(out) == 0 ? 0 : 2);
+}